@@ -0,0 +1,124 @@
+﻿using DoubleDouble;
+using System.Text;
+
+namespace SaSPoint5DistributionFP64Tests {
+    // binary reference datasets for SaSPoint5DistributionFP64_CPP/saspoint5_distribution_accuracy.hpp:
+    // 32 byte header (magic "SASPT5RF", version, function, count, reserved), then records of
+    // x and the expected value as hi + lo, little-endian doubles
+    [TestClass()]
+    public class SaSPoint5DistributionReference {
+        const uint version = 1;
+
+        enum Function : uint {
+            PDF, CDF, CCDF, Quantile, CQuantile
+        }
+
+        static SaSPoint5DistributionReference() {
+            Directory.CreateDirectory("../../../../results/");
+        }
+
+        static void Write(string filepath, Function function, IEnumerable<double> xs, Func<double, ddouble> expected) {
+            List<(double x, ddouble y)> records = xs.Select(x => (x, expected(x))).ToList();
+
+            using BinaryWriter bw = new(File.Create(filepath));
+
+            bw.Write(Encoding.ASCII.GetBytes("SASPT5RF"));
+            bw.Write(version);
+            bw.Write((uint)function);
+            bw.Write((ulong)records.Count);
+            bw.Write(0ul);
+
+            foreach ((double x, ddouble y) in records) {
+                double hi = (double)y, lo = (double.IsFinite(hi)) ? (double)(y - hi) : 0d;
+
+                bw.Write(x);
+                bw.Write(hi);
+                bw.Write(lo);
+            }
+        }
+
+        static IEnumerable<double> LinearGrid() {
+            for (double x = -6; x <= 64; x += 1d / 1024) {
+                yield return x;
+            }
+        }
+
+        static IEnumerable<double> NegativeGrid() {
+            for (double x = -64; x < -6; x += 1d / 1024) {
+                yield return x;
+            }
+        }
+
+        static IEnumerable<double> LimitGrid() {
+            for (double x0 = 64; x0 <= double.ScaleB(1, 64); x0 *= 2) {
+                for (double x = x0; x < x0 * 2; x += x0 / 256) {
+                    yield return x;
+                }
+            }
+        }
+
+        static IEnumerable<double> ProbabilityGrid() {
+            for (double x = 1d / 8192; x < 1; x += 1d / 8192) {
+                yield return x;
+            }
+        }
+
+        static IEnumerable<double> LowerTailGrid() {
+            for (double x0 = 1d / 8192; x0 > double.ScaleB(1, -128); x0 /= 2) {
+                for (double x = x0; x > x0 / 2; x -= x0 / 256) {
+                    yield return x;
+                }
+            }
+        }
+
+        [TestMethod()]
+        public void WritePDF() {
+            DoubleDoubleStatistic.ContinuousDistributions.SaSPoint5Distribution dist_fp128 = new();
+
+            Write(
+                "../../../../results/saspoint5_pdf_reference.bin", Function.PDF,
+                LinearGrid().Concat(LimitGrid()), x => dist_fp128.PDF(x)
+            );
+        }
+
+        [TestMethod()]
+        public void WriteCDF() {
+            DoubleDoubleStatistic.ContinuousDistributions.SaSPoint5Distribution dist_fp128 = new();
+
+            Write(
+                "../../../../results/saspoint5_cdf_reference.bin", Function.CDF,
+                NegativeGrid().Concat(LinearGrid()).Concat(LimitGrid().Select(x => -x)), x => dist_fp128.CDF(x, DoubleDoubleStatistic.Interval.Lower)
+            );
+        }
+
+        [TestMethod()]
+        public void WriteCCDF() {
+            DoubleDoubleStatistic.ContinuousDistributions.SaSPoint5Distribution dist_fp128 = new();
+
+            Write(
+                "../../../../results/saspoint5_ccdf_reference.bin", Function.CCDF,
+                LinearGrid().Concat(LimitGrid()), x => dist_fp128.CDF(x, DoubleDoubleStatistic.Interval.Upper)
+            );
+        }
+
+        [TestMethod()]
+        public void WriteQuantile() {
+            DoubleDoubleStatistic.ContinuousDistributions.SaSPoint5Distribution dist_fp128 = new();
+
+            Write(
+                "../../../../results/saspoint5_quantile_reference.bin", Function.Quantile,
+                ProbabilityGrid().Concat(LowerTailGrid()), x => dist_fp128.Quantile(x, DoubleDoubleStatistic.Interval.Lower)
+            );
+        }
+
+        [TestMethod()]
+        public void WriteCQuantile() {
+            DoubleDoubleStatistic.ContinuousDistributions.SaSPoint5Distribution dist_fp128 = new();
+
+            Write(
+                "../../../../results/saspoint5_cquantile_reference.bin", Function.CQuantile,
+                ProbabilityGrid().Concat(LowerTailGrid()), x => dist_fp128.Quantile(x, DoubleDoubleStatistic.Interval.Upper)
+            );
+        }
+    }
+}
@@ -1,113 +1,124 @@
 ﻿#include <iostream>
-#include <fstream>
-#include <iomanip>
-#include "saspoint5_distribution.hpp"
+#include <string_view>
+#include "saspoint5_distribution_sorted.hpp"
+#include "saspoint5_distribution_table.hpp"
 
-void plot_pdf(std::string filepath) {
-    ofstream ofs(filepath);
+using namespace std;
 
-    ofs << "x,pdf" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+// usage: SaSPoint5DistributionFP64_CPP [csv | binary]
 
-    for (double x = -6; x <= 64; x += 1. / 1024) {
-        ofs << x << ',' << saspoint5_pdf(x) << std::endl;
-    }
+static saspoint5_table_format format = saspoint5_table_format::csv;
 
-    ofs.close();
+static string table_path(const char* name) {
+    return string("../results/") + name + ((format == saspoint5_table_format::csv) ? ".csv" : ".bin");
 }
 
-void plot_pdf_limit(std::string filepath) {
-    ofstream ofs(filepath);
+static const saspoint5_table_column pdf_column = {
+    "pdf", [](span<const double> x, span<double> y) { saspoint5_pdf_sorted(x, y); }
+};
 
-    ofs << "x,pdf" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+static const saspoint5_table_column cdf_column = {
+    "cdf", [](span<const double> x, span<double> y) { saspoint5_cdf_sorted(x, y); }
+};
 
-    for (double x0 = 64; x0 <= ldexp(1, 64); x0 *= 2) {
-        for (double x = x0; x < x0 * 2; x += x0 / 256) {
-            ofs << x << ',' << saspoint5_pdf(x) << std::endl;
-        }
-    }
+static const saspoint5_table_column ccdf_column = {
+    "ccdf", [](span<const double> x, span<double> y) { saspoint5_cdf_sorted(x, y, true); }
+};
 
-    ofs.close();
-}
+static const saspoint5_table_column quantile_column = {
+    "quantile", [](span<const double> x, span<double> y) { saspoint5_quantile_sorted(x, y); }
+};
 
-void plot_cdf(std::string filepath) {
-    ofstream ofs(filepath);
+static const saspoint5_table_column cquantile_column = {
+    "cquantile", [](span<const double> x, span<double> y) { saspoint5_quantile_sorted(x, y, true); }
+};
 
-    ofs << "x,cdf,ccdf" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+// the grids accumulate x exactly as the former row-by-row loops did,
+// and are monotone for the *_sorted functions of the columns
+vector<double> linear_grid() {
+    vector<double> xs;
 
     for (double x = -6; x <= 64; x += 1. / 1024) {
-        ofs << x << ',' << saspoint5_cdf(x) << ',' << saspoint5_cdf(x, true) << std::endl;
+        xs.push_back(x);
     }
 
-    ofs.close();
+    return xs;
 }
 
-void plot_cdf_limit(std::string filepath) {
-    ofstream ofs(filepath);
-
-    ofs << "x,ccdf" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+vector<double> limit_grid() {
+    vector<double> xs;
 
     for (double x0 = 64; x0 <= ldexp(1, 64); x0 *= 2) {
         for (double x = x0; x < x0 * 2; x += x0 / 256) {
-            ofs << x << ',' << saspoint5_cdf(x, true) << std::endl;
+            xs.push_back(x);
         }
     }
 
-    ofs.close();
+    return xs;
 }
 
-void plot_quantile(std::string filepath) {
-    ofstream ofs(filepath);
+void plot_pdf(const char* name) {
+    saspoint5_write_table(table_path(name), "x", linear_grid(), span(&pdf_column, 1), format);
+}
+
+void plot_pdf_limit(const char* name) {
+    saspoint5_write_table(table_path(name), "x", limit_grid(), span(&pdf_column, 1), format);
+}
 
-    ofs << "x,quantile" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+void plot_cdf(const char* name) {
+    const saspoint5_table_column columns[] = { cdf_column, ccdf_column };
+
+    saspoint5_write_table(table_path(name), "x", linear_grid(), columns, format);
+}
+
+void plot_cdf_limit(const char* name) {
+    saspoint5_write_table(table_path(name), "x", limit_grid(), span(&ccdf_column, 1), format);
+}
+
+void plot_quantile(const char* name) {
+    vector<double> xs;
 
     for (double x = 1. / 8192; x < 1; x += 1. / 8192) {
-        ofs << x << ',' << saspoint5_quantile(x) << std::endl;
+        xs.push_back(x);
     }
 
-    ofs.close();
+    saspoint5_write_table(table_path(name), "x", xs, span(&quantile_column, 1), format);
 }
 
-void plot_quantilelower_limit(std::string filepath) {
-    ofstream ofs(filepath);
-
-    ofs << "x,quantile" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+void plot_quantilelower_limit(const char* name) {
+    vector<double> xs;
 
     for (double x = 1. / 8192; x > ldexp(1, -1000); x /= 2) {
-        ofs << x << ',' << saspoint5_quantile(x) << std::endl;
+        xs.push_back(x);
     }
 
-    ofs.close();
+    saspoint5_write_table(table_path(name), "x", xs, span(&quantile_column, 1), format);
 }
 
-void plot_quantileupper_limit(std::string filepath) {
-    ofstream ofs(filepath);
-
-    ofs << "x,cquantile" << std::endl;
-    ofs << std::scientific << std::setprecision(16);
+void plot_quantileupper_limit(const char* name) {
+    vector<double> xs;
 
     for (double x0 = 1. / 8192; x0 > ldexp(1, -128); x0 /= 2) {
         for (double x = x0; x > x0 / 2; x -= x0 / 256) {
-            ofs << x << ',' << saspoint5_quantile(x, true) << std::endl;
+            xs.push_back(x);
         }
     }
 
-    ofs.close();
+    saspoint5_write_table(table_path(name), "x", xs, span(&cquantile_column, 1), format);
 }
 
-int main() {
-    plot_pdf("../results/saspoint5_pdf_cpp.csv");
-    plot_pdf_limit("../results/saspoint5_pdf_limit_cpp.csv");
-    plot_cdf("../results/saspoint5_cdf_cpp.csv");
-    plot_cdf_limit("../results/saspoint5_cdf_limit_cpp.csv");
-    plot_quantile("../results/saspoint5_quantile_cpp.csv");
-    plot_quantilelower_limit("../results/saspoint5_quantilelower_limit_cpp.csv");
-    plot_quantileupper_limit("../results/saspoint5_quantileupper_limit_cpp.csv");
+int main(int argc, char** argv) {
+    if (argc > 1 && string_view(argv[1]) == "binary") {
+        format = saspoint5_table_format::binary;
+    }
+
+    plot_pdf("saspoint5_pdf_cpp");
+    plot_pdf_limit("saspoint5_pdf_limit_cpp");
+    plot_cdf("saspoint5_cdf_cpp");
+    plot_cdf_limit("saspoint5_cdf_limit_cpp");
+    plot_quantile("saspoint5_quantile_cpp");
+    plot_quantilelower_limit("saspoint5_quantilelower_limit_cpp");
+    plot_quantileupper_limit("saspoint5_quantileupper_limit_cpp");
 
     std::cout << "END" << std::endl;
-}
\ No newline at end of file
+}
@@ -0,0 +1,149 @@
+// ns per scalar pdf / cdf call with the former coefficient store (std::vector tables passed by value
+// to a horner poly, one heap copy per table per call) against the constexpr std::array tables
+// g++ -std=c++20 -O2 coefficient_tables.cpp
+// usage: coefficient_tables [n = 2^20]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../saspoint5_distribution.hpp"
+
+using namespace std;
+
+namespace former {
+    double poly(double x, vector<double> coef) {
+        double s = coef[coef.size() - 1];
+
+        for (int i = (int)coef.size() - 2; i >= 0; i--) {
+            s = s * x + coef[i];
+        }
+
+        return s;
+    }
+
+    double pade(double x, vector<double> numer, vector<double> denom) {
+        return poly(x, numer) / poly(x, denom);
+    }
+
+    struct table {
+        double offset;
+        vector<double> numer, denom;
+    };
+
+    // the current coefficients copied into function-local static vectors, as the former header kept them
+    template <size_t S>
+    const vector<table>& tables(const array<saspoint5_detail::pade_segment, S>& segments) {
+        static const vector<table> t = [&] {
+            vector<table> v;
+            for (const saspoint5_detail::pade_segment& segment : segments) {
+                v.push_back({ segment.offset, vector<double>(segment.numer.begin(), segment.numer.end()),
+                    vector<double>(segment.denom.begin(), segment.denom.end()) });
+            }
+            return v;
+        }();
+
+        return t;
+    }
+
+    // the former if/else ladder over (2^(e0 + n - 1), 2^(e0 + n)]
+    double pdf(double x) {
+        const vector<table>& t = tables(saspoint5_pdf_pade::pade_segments);
+
+        x = abs(x);
+
+        size_t index = 0;
+        for (double bound = 0.125; index + 1 < t.size() && x > bound; bound *= 2) {
+            index++;
+        }
+
+        if (index + 1 < t.size()) {
+            return pade(x - t[index].offset, t[index].numer, t[index].denom);
+        }
+
+        double u = 1 / sqrt(x);
+
+        return pade(u, t[index].numer, t[index].denom) * (u * u * u);
+    }
+
+    double cdf(double x, bool complementary = false) {
+        const vector<table>& t = tables(saspoint5_cdf_pade::pade_segments);
+
+        bool inversion = (x <= 0) ^ complementary;
+
+        x = abs(x);
+
+        size_t index = 0;
+        for (double bound = 0.5; index + 1 < t.size() && x > bound; bound *= 2) {
+            index++;
+        }
+
+        double y;
+        if (index + 1 < t.size()) {
+            y = pade(x - t[index].offset, t[index].numer, t[index].denom);
+        }
+        else {
+            double u = 1 / sqrt(x);
+
+            y = pade(u, t[index].numer, t[index].denom) * u;
+        }
+
+        return inversion ? y : 1 - y;
+    }
+}
+
+template <class F>
+double best_ns_per_call(const vector<double>& x, F func, int repeats = 5) {
+    double best = numeric_limits<double>::infinity();
+    volatile double sink = 0;
+
+    for (int r = 0; r < repeats; r++) {
+        double sum = 0;
+
+        auto t0 = chrono::steady_clock::now();
+        for (double v : x) {
+            sum += func(v);
+        }
+        auto t1 = chrono::steady_clock::now();
+
+        sink = sink + sum;
+        best = min(best, chrono::duration<double, nano>(t1 - t0).count() / (double)x.size());
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 20);
+
+    // |x| log-uniform over [2^-4, 2^8), covering every segment and the limit branch
+    mt19937_64 engine(1234);
+    uniform_real_distribution<double> e(-4, 8);
+
+    vector<double> x(n);
+    for (double& v : x) {
+        v = ((engine() & 1) ? 1 : -1) * exp2(e(engine));
+    }
+
+    double max_difference = 0;
+    for (double v : x) {
+        max_difference = max(max_difference, abs(former::pdf(v) / saspoint5_pdf(v) - 1));
+        max_difference = max(max_difference, abs(former::cdf(v) / saspoint5_cdf(v) - 1));
+    }
+
+    printf("function,former_ns_per_call,constexpr_ns_per_call,speedup\n");
+
+    double pdf_former = best_ns_per_call(x, [](double v) { return former::pdf(v); });
+    double pdf_now = best_ns_per_call(x, [](double v) { return saspoint5_pdf(v); });
+    printf("pdf,%.2f,%.2f,%.2f\n", pdf_former, pdf_now, pdf_former / pdf_now);
+
+    double cdf_former = best_ns_per_call(x, [](double v) { return former::cdf(v); });
+    double cdf_now = best_ns_per_call(x, [](double v) { return saspoint5_cdf(v); });
+    printf("cdf,%.2f,%.2f,%.2f\n", cdf_former, cdf_now, cdf_former / cdf_now);
+
+    // horner against estrin rounding only
+    fprintf(stderr, "max relative difference %.3e\n", max_difference);
+
+    return 0;
+}
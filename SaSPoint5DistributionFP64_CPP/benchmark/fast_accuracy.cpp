@@ -0,0 +1,103 @@
+// max relative error and throughput of saspoint5_fast against the full-accuracy batch functions
+// g++ -std=c++20 -O3 -march=native fast_accuracy.cpp
+// usage: fast_accuracy [n = 2^22] [tolerance...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../saspoint5_distribution_fast.hpp"
+
+using namespace std;
+
+template <class F>
+double best_seconds(F func, int repeats = 5) {
+    double best = numeric_limits<double>::infinity();
+
+    for (int r = 0; r < repeats; r++) {
+        auto t0 = chrono::steady_clock::now();
+        func();
+        auto t1 = chrono::steady_clock::now();
+
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+
+    return best;
+}
+
+double max_relative_error(const vector<double>& actual, const vector<double>& expected) {
+    double error = 0;
+
+    for (size_t i = 0; i < actual.size(); i++) {
+        if (expected[i] != 0 && isfinite(expected[i])) {
+            error = max(error, abs(actual[i] / expected[i] - 1));
+        }
+    }
+
+    return error;
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 22);
+
+    vector<double> tolerances;
+    for (int i = 2; i < argc; i++) {
+        tolerances.push_back(strtod(argv[i], nullptr));
+    }
+    if (tolerances.empty()) {
+        tolerances = { 1e-4, 1e-7, 1e-10 };
+    }
+
+    // |x| log-uniform in [2^-8, 2^16], p half uniform in (0, 1) and half log-uniform in [2^-80, 2^-1]
+    mt19937_64 engine(1234);
+    uniform_real_distribution<double> log2_x(-8, 16), log2_p(-80, -1), u(0, 1);
+
+    vector<double> x(n), p(n), y(n), expected(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = (i % 2 == 0 ? 1 : -1) * exp2(log2_x(engine));
+        p[i] = (i % 2 == 0) ? u(engine) : exp2(log2_p(engine));
+    }
+
+    printf("function,tolerance,cubics,max_relative_error,melements_per_second,pade_melements_per_second\n");
+
+    for (double tolerance : tolerances) {
+        saspoint5_fast fast(tolerance);
+
+        for (const char* name : { "pdf", "cdf", "ccdf", "quantile" }) {
+            bool complementary = name[1] == 'c';
+
+            auto exact = [&] {
+                if (name[0] == 'p') {
+                    saspoint5_pdf(x, expected);
+                }
+                else if (name[0] == 'c') {
+                    saspoint5_cdf(x, expected, complementary);
+                }
+                else {
+                    saspoint5_quantile(p, expected);
+                }
+            };
+
+            auto approx = [&] {
+                if (name[0] == 'p') {
+                    fast.pdf(x, y);
+                }
+                else if (name[0] == 'c') {
+                    fast.cdf(x, y, complementary);
+                }
+                else {
+                    fast.quantile(p, y);
+                }
+            };
+
+            double pade_seconds = best_seconds(exact);
+            double seconds = best_seconds(approx);
+
+            printf("%s,%.0e,%zu,%.3e,%.2f,%.2f\n", name, tolerance, fast.table_size(), max_relative_error(y, expected),
+                (double)n / seconds * 1e-6, (double)n / pade_seconds * 1e-6);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+// wall time of saspoint5_gof_test on n standard SaS(1/2) variates, split into the parallel sort
+// and the statistics over the sorted sample, of the same test fed as streamed chunks,
+// and of saspoint5_gof_bootstrap on a subsample
+// g++ -std=c++20 -O3 -march=native goodness_of_fit.cpp -ltbb
+// usage: goodness_of_fit [n = 2^24] [chunk = 2^20] [bootstrap_n = 4096] [replicates = 200]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../saspoint5_distribution_gof.hpp"
+
+using namespace std;
+
+template <class F>
+double seconds(F func) {
+    auto t0 = chrono::steady_clock::now();
+    func();
+    auto t1 = chrono::steady_clock::now();
+
+    return chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+    size_t chunk = (argc > 2) ? strtoull(argv[2], nullptr, 10) : (size_t(1) << 20);
+    size_t bootstrap_n = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 4096;
+    size_t replicates = (argc > 4) ? strtoull(argv[4], nullptr, 10) : 200;
+
+    saspoint5_sampler<mt19937_64> sampler(mt19937_64(1234));
+
+    vector<double> x(n);
+    sampler.fill(x);
+
+    vector<double> sorted = x;
+
+    double sort_seconds = seconds([&] { saspoint5_gof::sort(sorted); });
+
+    saspoint5_gof_result result;
+    double statistics_seconds = seconds([&] { result = saspoint5_gof_test_sorted(sorted); });
+
+    saspoint5_gof_result streamed;
+    double stream_seconds = seconds([&] {
+        saspoint5_gof_sample sample;
+
+        for (size_t i = 0; i < n; i += chunk) {
+            sample.append(span<const double>(x).subspan(i, min(chunk, n - i)));
+        }
+
+        streamed = sample.test();
+    });
+
+    saspoint5_gof_result bootstrap;
+    double bootstrap_seconds = seconds([&] {
+        bootstrap = saspoint5_gof_bootstrap(span<const double>(x).first(min(bootstrap_n, n)), replicates);
+    });
+
+    printf("n,sort_s,statistics_s,melements_per_second,stream_s,ks,ks_pvalue,ad,ad_pvalue\n");
+    printf("%zu,%.3f,%.3f,%.2f,%.3f,%.6e,%.4f,%.6e,%.4f\n", n, sort_seconds, statistics_seconds,
+        (double)n / statistics_seconds * 1e-6, stream_seconds, result.ks, result.ks_pvalue, result.ad, result.ad_pvalue);
+
+    printf("bootstrap_n,replicates,bootstrap_s,mu,c,ks,ks_pvalue,ad,ad_pvalue\n");
+    printf("%zu,%zu,%.3f,%.6f,%.6f,%.6e,%.4f,%.6e,%.4f\n", min(bootstrap_n, n), replicates, bootstrap_seconds,
+        bootstrap.mu, bootstrap.c, bootstrap.ks, bootstrap.ks_pvalue, bootstrap.ad, bootstrap.ad_pvalue);
+
+    return (streamed.ks == result.ks && streamed.ad == result.ad) ? 0 : 1;
+}
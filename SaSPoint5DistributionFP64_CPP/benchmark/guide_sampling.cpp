@@ -0,0 +1,81 @@
+// max relative error and throughput of saspoint5_guide_table against saspoint5_quantile,
+// and of saspoint5_sampler::fill with the inverse and guide methods
+// g++ -std=c++20 -O3 -march=native guide_sampling.cpp
+// usage: guide_sampling [n = 2^22] [tolerance...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../saspoint5_distribution_random.hpp"
+
+using namespace std;
+
+template <class F>
+double best_seconds(F func, int repeats = 5) {
+    double best = numeric_limits<double>::infinity();
+
+    for (int r = 0; r < repeats; r++) {
+        auto t0 = chrono::steady_clock::now();
+        func();
+        auto t1 = chrono::steady_clock::now();
+
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 22);
+
+    vector<double> tolerances;
+    for (int i = 2; i < argc; i++) {
+        tolerances.push_back(strtod(argv[i], nullptr));
+    }
+    if (tolerances.empty()) {
+        tolerances = { 1e-8, 1e-12, 1e-15 };
+    }
+
+    // u uniform in (0, 1), every fourth scaled into the tail down to 2^-60
+    mt19937_64 engine(1234);
+
+    vector<double> u(n), y(n), expected(n);
+    for (size_t i = 0; i < n; i++) {
+        u[i] = saspoint5_uniform_open01(engine);
+
+        if (i % 4 == 0) {
+            u[i] = ldexp(u[i], -(int)(engine() % 60));
+        }
+    }
+
+    double quantile_seconds = best_seconds([&] { saspoint5_quantile(u, expected); });
+
+    printf("tolerance,cubics,exact_octaves,build_ms,max_relative_error,melements_per_second,quantile_melements_per_second,"
+           "fill_msamples_per_second,inverse_fill_msamples_per_second\n");
+
+    for (double tolerance : tolerances) {
+        auto t0 = chrono::steady_clock::now();
+        saspoint5_guide_table guide(tolerance);
+        auto t1 = chrono::steady_clock::now();
+
+        double seconds = best_seconds([&] { guide.quantile(u, y); });
+
+        double error = 0;
+        for (size_t i = 0; i < n; i++) {
+            error = max(error, abs(y[i] / expected[i] - 1));
+        }
+
+        saspoint5_sampler<mt19937_64> inverse(mt19937_64(1)), sampler(mt19937_64(1), guide);
+
+        double inverse_fill_seconds = best_seconds([&] { inverse.fill(y); });
+        double fill_seconds = best_seconds([&] { sampler.fill(y); });
+
+        printf("%.0e,%zu,%zu,%.2f,%.3e,%.2f,%.2f,%.2f,%.2f\n", tolerance, guide.table_size(), guide.exact_octaves(),
+            chrono::duration<double, milli>(t1 - t0).count(), error,
+            (double)n / seconds * 1e-6, (double)n / quantile_seconds * 1e-6,
+            (double)n / fill_seconds * 1e-6, (double)n / inverse_fill_seconds * 1e-6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// scaling of the multithreaded batch evaluation from 1 to N threads
+// g++ -std=c++20 -O3 -march=native -pthread parallel_scaling.cpp -ltbb
+// usage: parallel_scaling [n = 2^27] [max threads = hardware concurrency]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include "../saspoint5_distribution_parallel.hpp"
+
+using namespace std;
+
+template <class F>
+double best_seconds(F func, int repeats = 5) {
+    double best = numeric_limits<double>::infinity();
+
+    for (int r = 0; r < repeats; r++) {
+        auto t0 = chrono::steady_clock::now();
+        func();
+        auto t1 = chrono::steady_clock::now();
+
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 27);
+    size_t max_threads = (argc > 2) ? strtoull(argv[2], nullptr, 10) : max(thread::hardware_concurrency(), 1u);
+
+    unique_ptr<double[]> x_buffer(new double[n]), y_buffer(new double[n]);
+    span<double> x(x_buffer.get(), n), y(y_buffer.get(), n);
+
+    saspoint5_first_touch(x, max_threads);
+    saspoint5_first_touch(y, max_threads);
+
+    saspoint5_parallel::for_each_chunk(n, [&](size_t begin, size_t end) {
+        mt19937_64 engine(begin);
+        uniform_real_distribution<double> u(0, 1);
+
+        for (size_t i = begin; i < end; i++) {
+            x[i] = u(engine);
+        }
+    }, max_threads);
+
+    printf("function,threads,n,seconds,melements_per_second,speedup\n");
+
+    for (const char* name : { "pdf", "cdf", "quantile" }) {
+        double base = 0;
+
+        for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+            double seconds = best_seconds([&] {
+                saspoint5_parallel::for_each_chunk(n, [&](size_t begin, size_t end) {
+                    span<const double> xs = x.subspan(begin, end - begin);
+                    span<double> ys = y.subspan(begin, end - begin);
+
+                    if (name[0] == 'p') {
+                        saspoint5_pdf(xs, ys);
+                    }
+                    else if (name[0] == 'c') {
+                        saspoint5_cdf(xs, ys);
+                    }
+                    else {
+                        saspoint5_quantile(xs, ys);
+                    }
+                }, threads);
+            });
+
+            base = (threads == 1) ? seconds : base;
+
+            printf("%s,%zu,%zu,%.6f,%.2f,%.3f\n", name, threads, n, seconds, (double)n / seconds * 1e-6, base / seconds);
+
+            if (threads < max_threads && threads * 2 > max_threads) {
+                threads = max_threads / 2;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+// per-segment relative error of the batch functions against binary reference datasets
+// g++ -std=c++20 -O3 -march=native -pthread reference_accuracy.cpp -ltbb
+// usage: reference_accuracy [--tolerance t] reference.bin...
+//
+// references are written by SaSPoint5DistributionFP64Tests/SaSPoint5DistributionReference.cs
+// exit status 1 when the max relative error of any segment exceeds the tolerance
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include "../saspoint5_distribution_accuracy.hpp"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    double tolerance = numeric_limits<double>::infinity();
+    vector<string> filepaths;
+
+    for (int i = 1; i < argc; i++) {
+        if (string_view(argv[i]) == "--tolerance" && i + 1 < argc) {
+            tolerance = strtod(argv[++i], nullptr);
+        }
+        else {
+            filepaths.push_back(argv[i]);
+        }
+    }
+
+    constexpr const char* function_names[] = { "pdf", "cdf", "ccdf", "quantile", "cquantile" };
+
+    printf("file,function,segment,count,max_relative_error,x_at_max,p50,p99,p999\n");
+
+    bool passed = true;
+
+    for (const string& filepath : filepaths) {
+        try {
+            saspoint5_reference_file reference(filepath);
+
+            auto t0 = chrono::steady_clock::now();
+            vector<saspoint5_segment_accuracy> accuracy = saspoint5_evaluate_accuracy(reference);
+            auto t1 = chrono::steady_clock::now();
+
+            size_t function = (size_t)reference.header().function;
+
+            for (size_t s = 0; s < accuracy.size(); s++) {
+                const saspoint5_segment_accuracy& a = accuracy[s];
+
+                printf("%s,%s,%zu,%zu,%.3e,%.17g,%.3e,%.3e,%.3e\n", filepath.c_str(),
+                    (function < size(function_names)) ? function_names[function] : "?", s, a.count,
+                    a.max_error, a.x_at_max, a.p50, a.p99, a.p999);
+
+                passed &= !(a.max_error > tolerance);
+            }
+
+            fprintf(stderr, "%s: %zu records in %.3f s\n", filepath.c_str(), reference.records().size(),
+                chrono::duration<double>(t1 - t0).count());
+        }
+        catch (const runtime_error& e) {
+            fprintf(stderr, "%s\n", e.what());
+            passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+// Msamples/s of saspoint5_sampler with the inverse and levy methods, one variate per call and
+// through fill(), for 64 and 32 bit engines, with the fraction of samples beyond |x| > 100
+// against the exact tail mass 2 saspoint5_cdf(-100) as a sanity check
+// g++ -std=c++20 -O3 -march=native sampling_methods.cpp
+// usage: sampling_methods [n = 2^22]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../saspoint5_distribution_random.hpp"
+
+using namespace std;
+
+template <class F>
+double best_seconds(F func, int repeats = 5) {
+    double best = numeric_limits<double>::infinity();
+
+    for (int r = 0; r < repeats; r++) {
+        auto t0 = chrono::steady_clock::now();
+        func();
+        auto t1 = chrono::steady_clock::now();
+
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+
+    return best;
+}
+
+template <class URBG>
+void benchmark(const char* engine_name, size_t n) {
+    const double tail_expected = 2 * saspoint5_cdf(-100.0);
+
+    vector<double> y(n);
+
+    for (saspoint5_sampling method : { saspoint5_sampling::inverse, saspoint5_sampling::levy }) {
+        const char* method_name = (method == saspoint5_sampling::inverse) ? "inverse" : "levy";
+
+        saspoint5_sampler<URBG> sampler(URBG(1234), method);
+
+        double scalar_seconds = best_seconds([&] {
+            for (double& v : y) {
+                v = sampler();
+            }
+        });
+
+        double fill_seconds = best_seconds([&] { sampler.fill(y); });
+
+        size_t tail = (size_t)count_if(y.begin(), y.end(), [](double v) { return abs(v) > 100; });
+
+        printf("%s,%s,%.2f,%.2f,%.5f,%.5f\n", engine_name, method_name,
+            (double)n / scalar_seconds * 1e-6, (double)n / fill_seconds * 1e-6,
+            (double)tail / (double)n, tail_expected);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 22);
+
+    printf("engine,method,scalar_msamples_per_second,fill_msamples_per_second,tail_fraction,tail_expected\n");
+
+    benchmark<mt19937_64>("mt19937_64", n);
+    benchmark<mt19937>("mt19937", n);
+    benchmark<minstd_rand>("minstd_rand", n);
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+// latency and throughput of pdf, cdf, ccdf and quantile per pade segment and per input distribution
+// g++ -std=c++20 -O3 -march=native segment_benchmark.cpp
+// usage: segment_benchmark [n = 2^16] > result.csv
+//
+// latency:    scalar calls chained through their results, ns per call
+// throughput: independent scalar calls over the array
+// batch:      the span overload over the array
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../saspoint5_distribution_random.hpp"
+
+using namespace std;
+
+struct input_case {
+    string name;
+    vector<double> x;
+};
+
+template <class F>
+double best_seconds(F func, int repeats = 7) {
+    double best = numeric_limits<double>::infinity();
+
+    for (int r = 0; r < repeats; r++) {
+        auto t0 = chrono::steady_clock::now();
+        func();
+        auto t1 = chrono::steady_clock::now();
+
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+
+    return best;
+}
+
+static string number(double v) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", v);
+
+    return buffer;
+}
+
+// |x| uniform in (lo, hi], random sign
+static vector<double> uniform_abs(mt19937_64& engine, size_t n, double lo, double hi) {
+    uniform_real_distribution<double> u(lo, hi);
+
+    vector<double> x(n);
+    for (double& v : x) {
+        v = (engine() & 1) ? u(engine) : -u(engine);
+    }
+
+    return x;
+}
+
+// 2^e, e uniform in [e_lo, e_hi)
+static vector<double> log_uniform(mt19937_64& engine, size_t n, double e_lo, double e_hi) {
+    uniform_real_distribution<double> u(e_lo, e_hi);
+
+    vector<double> x(n);
+    for (double& v : x) {
+        v = exp2(u(engine));
+    }
+
+    return x;
+}
+
+// pdf and cdf share the layout: [0, b0], (b0, b1], ..., limit beyond the last bound
+static vector<input_case> segment_inputs(mt19937_64& engine, size_t n, span<const double> bounds) {
+    vector<input_case> inputs;
+
+    double lo = 0;
+    for (double hi : bounds) {
+        inputs.push_back({ "segment:(" + number(lo) + "," + number(hi) + "]", uniform_abs(engine, n, lo, hi) });
+        lo = hi;
+    }
+
+    vector<double> x = log_uniform(engine, n, log2(lo), 64);
+    for (size_t i = 0; i < n; i += 2) {
+        x[i] = -x[i];
+    }
+
+    inputs.push_back({ "segment:limit", x });
+
+    return inputs;
+}
+
+static vector<input_case> distribution_inputs(mt19937_64& engine, size_t n) {
+    saspoint5_sampler<mt19937_64> sampler(mt19937_64{ engine() });
+
+    vector<double> sample(n);
+    sampler.fill(sample);
+
+    vector<double> sorted = sample;
+    sort(sorted.begin(), sorted.end());
+
+    return {
+        { "uniform:[-64,64]", uniform_abs(engine, n, 0, 64) },
+        { "saspoint5", sample },
+        { "saspoint5:sorted", sorted },
+    };
+}
+
+static vector<input_case> quantile_inputs(mt19937_64& engine, size_t n) {
+    vector<input_case> inputs;
+
+    // head segments: u = -log2(2p) in [0, 0.125], (0.125, 0.25], (0.25, 0.5], (0.5, 1]
+    double u_lo = 0;
+    for (double u_hi : { 0.125, 0.25, 0.5, 1.0 }) {
+        vector<double> p = log_uniform(engine, n, -u_hi - 1, -u_lo - 1);
+
+        inputs.push_back({ "segment:u(" + number(u_lo) + "," + number(u_hi) + "]", p });
+        u_lo = u_hi;
+    }
+
+    // tail segments by the exponent of p, then the constant below 2^-64
+    int e_hi = -2;
+    for (int e_lo : { -4, -8, -16, -32, -64 }) {
+        inputs.push_back({ "segment:p[2^" + to_string(e_lo) + ",2^" + to_string(e_hi) + ")", log_uniform(engine, n, e_lo, e_hi) });
+        e_hi = e_lo;
+    }
+
+    // the quantile stays finite down to 2^-500
+    inputs.push_back({ "segment:p<2^-64", log_uniform(engine, n, -500, -64) });
+
+    vector<double> p(n);
+    for (double& v : p) {
+        v = saspoint5_uniform_open01(engine);
+    }
+
+    vector<double> sorted = p;
+    sort(sorted.begin(), sorted.end());
+
+    inputs.push_back({ "uniform:(0,1)", p });
+    inputs.push_back({ "loguniform:[2^-64,1)", log_uniform(engine, n, -64, 0) });
+    inputs.push_back({ "uniform:sorted", sorted });
+
+    return inputs;
+}
+
+template <class Scalar, class Batch>
+void run(const char* name, const vector<input_case>& inputs, Scalar scalar, Batch batch) {
+    for (const input_case& input : inputs) {
+        const vector<double>& x = input.x;
+        size_t n = x.size();
+
+        vector<double> y(n);
+
+        // v * 0 puts every call on the critical path of the previous one; all results are finite
+        double latency = best_seconds([&] {
+            double v = 0;
+            for (size_t i = 0; i < n; i++) {
+                v = scalar(x[i] + v * 0.0);
+            }
+            y[0] = v;
+        });
+
+        double throughput = best_seconds([&] {
+            for (size_t i = 0; i < n; i++) {
+                y[i] = scalar(x[i]);
+            }
+        });
+
+        double batch_seconds = best_seconds([&] {
+            batch(span<const double>(x), span<double>(y));
+        });
+
+        for (auto [method, seconds] : { pair{ "latency", latency }, pair{ "throughput", throughput }, pair{ "batch", batch_seconds } }) {
+            printf("%s,%s,%s,%zu,%.3f,%.2f\n", name, input.name.c_str(), method, n, seconds * 1e9 / (double)n, (double)n / seconds * 1e-6);
+        }
+
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 16);
+
+    mt19937_64 engine(1234);
+
+    vector<input_case> pdf_inputs = segment_inputs(engine, n, saspoint5_simd::pdf::bounds);
+    vector<input_case> cdf_inputs = segment_inputs(engine, n, saspoint5_simd::cdf::bounds);
+    vector<input_case> distributions = distribution_inputs(engine, n);
+
+    pdf_inputs.insert(pdf_inputs.end(), distributions.begin(), distributions.end());
+    cdf_inputs.insert(cdf_inputs.end(), distributions.begin(), distributions.end());
+
+    printf("function,input,method,n,ns_per_call,melements_per_second\n");
+
+    run("pdf", pdf_inputs,
+        [](double x) { return saspoint5_pdf(x); },
+        [](span<const double> x, span<double> y) { saspoint5_pdf(x, y); });
+
+    run("cdf", cdf_inputs,
+        [](double x) { return saspoint5_cdf(x); },
+        [](span<const double> x, span<double> y) { saspoint5_cdf(x, y); });
+
+    run("ccdf", cdf_inputs,
+        [](double x) { return saspoint5_cdf(x, true); },
+        [](span<const double> x, span<double> y) { saspoint5_cdf(x, y, true); });
+
+    run("quantile", quantile_inputs(engine, n),
+        [](double p) { return saspoint5_quantile(p); },
+        [](span<const double> p, span<double> y) { saspoint5_quantile(p, y); });
+
+    return 0;
+}
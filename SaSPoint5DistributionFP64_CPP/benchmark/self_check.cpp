@@ -0,0 +1,209 @@
+// self-checks of the estimation and sampling utilities on seeded samples
+//   fit:   saspoint5_fit recovers (mu, c) of a SaS(1/2) sample drawn by saspoint5_sampler
+//   guide: saspoint5_guide_table agrees with saspoint5_quantile within its tolerance, its span overload
+//          with the scalar one bit for bit, and each sampling method puts the exact mass beyond |x| > 100
+//   gof:   saspoint5_gof_test agrees with a naive long double evaluation of D and A^2 from the scalar
+//          cdf, and saspoint5_gof_bootstrap p-values are reproducible from the seed
+//   interval: saspoint5_interval_probability masses are non-negative and sum to 1 over bins from
+//          -inf to inf, including tail octaves and bins narrower than an ulp of the cdf at the median
+// g++ -std=c++20 -O3 -march=native -pthread self_check.cpp -ltbb
+// usage: self_check [n = 2^16]
+//
+// exit status 1 when any check fails
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../saspoint5_distribution_fit.hpp"
+#include "../saspoint5_distribution_gof.hpp"
+#include "../saspoint5_distribution_random.hpp"
+
+using namespace std;
+
+static bool passed = true;
+
+static void check(const char* name, bool ok, double value, double bound) {
+    printf("%s,%s,%.6e,%.6e\n", name, ok ? "pass" : "FAIL", value, bound);
+
+    passed &= ok;
+}
+
+static void check_fit(size_t n) {
+    constexpr double mu = 3.0, c = 0.25;
+
+    saspoint5_sampler<mt19937_64> sampler(mt19937_64(1234));
+
+    vector<double> x(n);
+    sampler.fill(x);
+
+    for (double& v : x) {
+        v = mu + c * v;
+    }
+
+    saspoint5_fit_result fit = saspoint5_fit(x);
+
+    check("fit_converged", fit.converged, (double)fit.iterations, 64);
+
+    // the standard errors of both are close to sqrt(2 / n) (in units of c, and relative for c)
+    double bound = 8 * sqrt(2.0 / (double)n);
+
+    check("fit_mu", abs(fit.mu - mu) / c <= bound, abs(fit.mu - mu) / c, bound);
+    check("fit_c", abs(fit.c / c - 1) <= bound, abs(fit.c / c - 1), bound);
+
+    // the estimate is a maximum: moving either parameter lowers the log-likelihood
+    saspoint5_distribution distribution(fit.mu, fit.c);
+    double l = distribution.loglikelihood(x);
+
+    double worst = -numeric_limits<double>::infinity();
+    for (double delta : { -1e-3, 1e-3 }) {
+        worst = max(worst, saspoint5_distribution(fit.mu + delta * fit.c, fit.c).loglikelihood(x) - l);
+        worst = max(worst, saspoint5_distribution(fit.mu, fit.c * (1 + delta)).loglikelihood(x) - l);
+    }
+
+    check("fit_maximum", worst <= 0, worst, 0);
+}
+
+static void check_guide(size_t n) {
+    const saspoint5_guide_table& guide = saspoint5_guide_table::standard();
+
+    // uniforms of the sampler, and every octave of both tails at 1/16 octave steps
+    mt19937_64 engine(1234);
+
+    vector<double> u(n);
+    for (double& v : u) {
+        v = saspoint5_uniform_open01(engine);
+    }
+    for (int k = 16; k <= 53 * 16; k++) {
+        double p = exp2(-(double)k / 16);
+
+        u.push_back(p);
+        u.push_back(1 - p);
+    }
+
+    vector<double> y(u.size());
+    guide.quantile(u, y);
+
+    double error = 0;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < u.size(); i++) {
+        double expected = saspoint5_quantile(u[i]);
+
+        error = max(error, abs(guide.quantile(u[i]) - expected) / abs(expected));
+        mismatches += (bit_cast<uint64_t>(y[i]) != bit_cast<uint64_t>(guide.quantile(u[i]))) ? 1 : 0;
+    }
+
+    check("guide_quantile", error <= guide.tolerance(), error, guide.tolerance());
+    check("guide_span", mismatches == 0, (double)mismatches, 0);
+
+    // binomial fraction of samples beyond |x| > 100, against 6 standard deviations
+    const double tail = 2 * saspoint5_cdf(-100.0);
+    const double bound = 6 * sqrt(tail * (1 - tail) / (double)n);
+
+    for (saspoint5_sampling method : { saspoint5_sampling::inverse, saspoint5_sampling::levy, saspoint5_sampling::guide }) {
+        saspoint5_sampler<mt19937_64> sampler(mt19937_64(5678), method);
+
+        vector<double> x(n);
+        sampler.fill(x);
+
+        double fraction = (double)count_if(x.begin(), x.end(), [](double v) { return abs(v) > 100; }) / (double)n;
+
+        const char* name = (method == saspoint5_sampling::inverse) ? "sampler_tail_inverse"
+            : (method == saspoint5_sampling::levy) ? "sampler_tail_levy" : "sampler_tail_guide";
+
+        check(name, abs(fraction - tail) <= bound, abs(fraction - tail), bound);
+    }
+}
+
+static void check_gof(size_t n) {
+    saspoint5_sampler<mt19937_64> sampler(mt19937_64(9012));
+
+    vector<double> x(n);
+    sampler.fill(x);
+
+    saspoint5_gof_result result = saspoint5_gof_test(x);
+
+    vector<double> sorted = x;
+    sort(sorted.begin(), sorted.end());
+
+    long double d = 0, a = 0, nn = (long double)n;
+    for (size_t i = 0; i < n; i++) {
+        long double k = (long double)i;
+        long double cdf = saspoint5_cdf(sorted[i]), ccdf = saspoint5_cdf(sorted[i], true);
+
+        d = max(d, max((k + 1) / nn - cdf, cdf - k / nn));
+        a += (2 * k + 1) * logl(cdf) + (2 * (nn - k) - 1) * logl(ccdf);
+    }
+    a = -nn - a / nn;
+
+    // A^2 cancels sums of size n, so its error bound grows with n
+    double ks_error = abs((double)((result.ks - d) / d)), ad_error = abs((double)(result.ad - a));
+    double ad_bound = 64 * numeric_limits<double>::epsilon() * (double)n;
+
+    check("gof_ks", ks_error <= 1e-12, ks_error, 1e-12);
+    check("gof_ad", ad_error <= ad_bound, ad_error, ad_bound);
+
+    // replicates are seeded by index, so the p-values must not depend on the scheduling
+    span<const double> head(x.data(), min<size_t>(n, 1024));
+
+    saspoint5_gof_result first = saspoint5_gof_bootstrap(head, 64, 3456);
+    saspoint5_gof_result second = saspoint5_gof_bootstrap(head, 64, 3456);
+
+    bool same = first.ks_pvalue == second.ks_pvalue && first.ad_pvalue == second.ad_pvalue;
+
+    check("gof_bootstrap", same, abs(first.ks_pvalue - second.ks_pvalue) + abs(first.ad_pvalue - second.ad_pvalue), 0);
+}
+
+static void check_interval() {
+    vector<double> edges = { -numeric_limits<double>::infinity(), numeric_limits<double>::infinity() };
+
+    for (int k = -80; k <= 256; k++) {
+        edges.push_back(exp2((double)k / 4));
+        edges.push_back(-exp2((double)k / 4));
+    }
+    for (int k = -1024; k <= 1024; k++) {
+        edges.push_back((double)k / 1024);
+        edges.push_back((double)k * 1e-17);
+    }
+
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    vector<double> probability(edges.size() - 1);
+
+    // each clamped bin can add up to an ulp of 1/2 to the sum
+    const double bound = numeric_limits<double>::epsilon() * (double)probability.size();
+
+    for (auto [mu, c] : { pair(0.0, 1.0), pair(3.0, 0.25) }) {
+        vector<double> x = edges;
+        for (double& v : x) {
+            v = mu + c * v;
+        }
+
+        saspoint5_distribution(mu, c).interval_probability(x, probability);
+
+        long double sum = 0;
+        double minimum = numeric_limits<double>::infinity();
+        for (double p : probability) {
+            sum += p;
+            minimum = min(minimum, p);
+        }
+
+        double error = abs((double)(sum - 1));
+
+        check((mu == 0) ? "interval_nonnegative" : "interval_nonnegative_scaled", minimum >= 0, minimum, 0);
+        check((mu == 0) ? "interval_sum" : "interval_sum_scaled", error <= bound, error, bound);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 16);
+
+    printf("check,result,value,bound\n");
+
+    check_fit(n);
+    check_guide(n);
+    check_gof(n);
+    check_interval();
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+# Author and Approximation Formula Coefficient Generator: T.Yoshimura
+# Github: https://github.com/tk-yoshimura
+# Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+# ctypes binding of saspoint5_distribution_capi.h
+#
+# pdf, cdf and quantile take a scalar or anything numpy.asarray accepts (ndarray, buffer-protocol objects).
+# C-contiguous float64 and float32 arrays are passed to the library by pointer without a copy, other
+# inputs are converted to float64 first. out receives the result in place; it must be a writeable,
+# C-contiguous array of the input shape and dtype, and may be x itself.
+# The library is libsaspoint5_distribution.so (saspoint5_distribution.dll, libsaspoint5_distribution.dylib)
+# next to this file, or the path in SASPOINT5_LIBRARY. The GIL is released during each call.
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+ABI_VERSION = 1
+
+_filenames = {
+    'win32': 'saspoint5_distribution.dll',
+    'darwin': 'libsaspoint5_distribution.dylib',
+}
+
+
+def _load():
+    path = os.environ.get('SASPOINT5_LIBRARY') or os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), _filenames.get(sys.platform, 'libsaspoint5_distribution.so'))
+
+    lib = ctypes.CDLL(path)
+
+    lib.saspoint5_abi_version.argtypes = []
+    lib.saspoint5_abi_version.restype = ctypes.c_int
+
+    if lib.saspoint5_abi_version() != ABI_VERSION:
+        raise ImportError(f'{path}: abi version {lib.saspoint5_abi_version()}, expected {ABI_VERSION}')
+
+    for suffix in ['', 'f']:
+        for name, args in [('pdf', []), ('cdf', [ctypes.c_int]), ('quantile', [ctypes.c_int])]:
+            # attribute access caches the function object, lib[name] would return a new one
+            func = getattr(lib, f'saspoint5_{name}_array' + suffix)
+            func.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t] + args
+            func.restype = ctypes.c_int
+
+    return lib
+
+
+_lib = _load()
+
+
+def _evaluate(name, x, out, *args):
+    scalar = np.ndim(x) == 0 and out is None
+
+    x = np.asarray(x)
+    if x.dtype not in (np.float64, np.float32):
+        x = x.astype(np.float64)
+    if not x.flags.c_contiguous:
+        x = np.ascontiguousarray(x)
+
+    if out is None:
+        out = np.empty_like(x)
+    elif not (isinstance(out, np.ndarray) and out.dtype == x.dtype and out.shape == x.shape
+              and out.flags.c_contiguous and out.flags.writeable):
+        raise ValueError(f'out must be a writeable C-contiguous {x.dtype} array of shape {x.shape}')
+    elif out is not x and np.shares_memory(out, x):
+        raise ValueError('out overlaps x')
+
+    func = getattr(_lib, f'saspoint5_{name}_array' + ('f' if x.dtype == np.float32 else ''))
+
+    status = func(x.ctypes.data, out.ctypes.data, x.size, *args)
+    if status != 0:
+        raise RuntimeError(f'saspoint5_{name}: status {status}')
+
+    return out[()] if scalar else out
+
+
+def pdf(x, out=None):
+    return _evaluate('pdf', x, out)
+
+
+def cdf(x, complementary=False, out=None):
+    return _evaluate('cdf', x, out, int(complementary))
+
+
+def quantile(p, complementary=False, out=None):
+    return _evaluate('quantile', p, out, int(complementary))
@@ -0,0 +1,79 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C ABI
+//
+// The shared library behind saspoint5_distribution_capi.h; build lines are in the header.
+
+#include <exception>
+
+#include "../saspoint5_distribution_parallel.hpp"
+#include "../saspoint5_distribution_float.hpp"
+
+#ifndef SASPOINT5_BUILD_DLL
+#define SASPOINT5_BUILD_DLL
+#endif
+#include "saspoint5_distribution_capi.h"
+
+namespace saspoint5_capi {
+    // func(x, y) over the chunks of [0, n); exceptions must not cross the C boundary
+    template <class T, class F>
+    int for_each_chunk(const T* x, T* y, size_t n, F func) {
+        if (n > 0 && (x == nullptr || y == nullptr)) {
+            return SASPOINT5_INVALID_ARGUMENT;
+        }
+
+        try {
+            saspoint5_parallel::for_each_chunk(n, [&](size_t begin, size_t end) {
+                func(std::span<const T>(x + begin, end - begin), std::span<T>(y + begin, end - begin));
+            });
+        }
+        catch (...) {
+            return SASPOINT5_FAILED;
+        }
+
+        return SASPOINT5_OK;
+    }
+}
+
+extern "C" {
+    int saspoint5_abi_version(void) {
+        return SASPOINT5_ABI_VERSION;
+    }
+
+    int saspoint5_pdf_array(const double* x, double* y, size_t n) {
+        return saspoint5_capi::for_each_chunk(x, y, n, [](std::span<const double> xs, std::span<double> ys) {
+            saspoint5_pdf(xs, ys);
+        });
+    }
+
+    int saspoint5_cdf_array(const double* x, double* y, size_t n, int complementary) {
+        return saspoint5_capi::for_each_chunk(x, y, n, [=](std::span<const double> xs, std::span<double> ys) {
+            saspoint5_cdf(xs, ys, complementary != 0);
+        });
+    }
+
+    int saspoint5_quantile_array(const double* x, double* y, size_t n, int complementary) {
+        return saspoint5_capi::for_each_chunk(x, y, n, [=](std::span<const double> xs, std::span<double> ys) {
+            saspoint5_quantile(xs, ys, complementary != 0);
+        });
+    }
+
+    int saspoint5_pdf_arrayf(const float* x, float* y, size_t n) {
+        return saspoint5_capi::for_each_chunk(x, y, n, [](std::span<const float> xs, std::span<float> ys) {
+            saspoint5_pdf(xs, ys);
+        });
+    }
+
+    int saspoint5_cdf_arrayf(const float* x, float* y, size_t n, int complementary) {
+        return saspoint5_capi::for_each_chunk(x, y, n, [=](std::span<const float> xs, std::span<float> ys) {
+            saspoint5_cdf(xs, ys, complementary != 0);
+        });
+    }
+
+    int saspoint5_quantile_arrayf(const float* x, float* y, size_t n, int complementary) {
+        return saspoint5_capi::for_each_chunk(x, y, n, [=](std::span<const float> xs, std::span<float> ys) {
+            saspoint5_quantile(xs, ys, complementary != 0);
+        });
+    }
+}
@@ -0,0 +1,63 @@
+/* Author and Approximation Formula Coefficient Generator: T.Yoshimura
+ * Github: https://github.com/tk-yoshimura
+ * Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+ * C ABI
+ *
+ * Stable C entry points of the batch functions for FFI (ctypes, cffi, P/Invoke, ...).
+ * Each function evaluates n elements of x into y, contiguous arrays owned by the caller; nothing is
+ * copied or allocated. y may be the same array as x, other overlaps are not allowed.
+ * Arrays of at least saspoint5_distribution_parallel.hpp min_parallel_size elements per thread are split
+ * over the threads of a pool started on first use. The functions never throw; they return SASPOINT5_OK
+ * or a negative status.
+ *
+ * Build (saspoint5_distribution_capi.cpp):
+ *   g++ -std=c++20 -O3 -DNDEBUG -shared -fPIC -fvisibility=hidden -DSASPOINT5_DISPATCH -Wno-psabi saspoint5_distribution_capi.cpp -o libsaspoint5_distribution.so
+ *   cl /std:c++20 /O2 /EHsc /LD /DNDEBUG /DSASPOINT5_BUILD_DLL saspoint5_distribution_capi.cpp /Fe:saspoint5_distribution.dll
+ * SASPOINT5_DISPATCH selects the avx2/avx512 double kernels at run time, so one binary serves every x86-64 cpu;
+ * the float kernels follow the compile flags.
+ */
+
+#ifndef SASPOINT5_DISTRIBUTION_CAPI_H
+#define SASPOINT5_DISTRIBUTION_CAPI_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#if defined(SASPOINT5_BUILD_DLL)
+#define SASPOINT5_API __declspec(dllexport)
+#else
+#define SASPOINT5_API __declspec(dllimport)
+#endif
+#else
+#define SASPOINT5_API __attribute__((visibility("default")))
+#endif
+
+/* incremented only when an existing signature or behaviour changes */
+#define SASPOINT5_ABI_VERSION 1
+
+#define SASPOINT5_OK 0
+/* x or y is null while n > 0 */
+#define SASPOINT5_INVALID_ARGUMENT -1
+/* the evaluation failed (out of memory, system error); the contents of y are unspecified */
+#define SASPOINT5_FAILED -2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SASPOINT5_API int saspoint5_abi_version(void);
+
+/* complementary != 0: ccdf, and the quantile of the upper tail */
+SASPOINT5_API int saspoint5_pdf_array(const double* x, double* y, size_t n);
+SASPOINT5_API int saspoint5_cdf_array(const double* x, double* y, size_t n, int complementary);
+SASPOINT5_API int saspoint5_quantile_array(const double* x, double* y, size_t n, int complementary);
+
+SASPOINT5_API int saspoint5_pdf_arrayf(const float* x, float* y, size_t n);
+SASPOINT5_API int saspoint5_cdf_arrayf(const float* x, float* y, size_t n, int complementary);
+SASPOINT5_API int saspoint5_quantile_arrayf(const float* x, float* y, size_t n, int complementary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
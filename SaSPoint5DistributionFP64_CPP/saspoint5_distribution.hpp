@@ -7,35 +7,476 @@
 
 #pragma once
 
-#include <vector>
+#include <array>
+#include <span>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <cmath>
 #include <cassert>
 #include <numbers>
 #include <limits>
+#include <type_traits>
+
+
+// replacements for the <cmath> calls of saspoint5_pdf/cdf/quantile that are usable in constant expressions;
+// outside constant evaluation they call <cmath>. sqrt is correctly rounded by an integer square root,
+// fma is exact by rounding the error terms to odd (Boldo and Melquiond, 2008) for operands whose product
+// neither overflows nor underflows.
+namespace saspoint5_constexpr {
+    constexpr double abs(double x) {
+        if (!std::is_constant_evaluated()) {
+            return std::abs(x);
+        }
+
+        return std::bit_cast<double>(std::bit_cast<uint64_t>(x) & 0x7FFFFFFFFFFFFFFFull);
+    }
+
+    // r^2 <= hi 2^64 + lo, r < 2^54
+    constexpr bool square_le(uint64_t r, uint64_t hi, uint64_t lo) {
+        uint64_t a = r >> 32, b = r & 0xFFFFFFFFull, mid = 2 * a * b;
+
+        uint64_t sq_lo = b * b + (mid << 32);
+        uint64_t sq_hi = a * a + (mid >> 32) + ((sq_lo < b * b) ? 1 : 0);
+
+        return (sq_hi < hi) || (sq_hi == hi && sq_lo <= lo);
+    }
+
+    constexpr double sqrt(double x) {
+        if (!std::is_constant_evaluated()) {
+            return std::sqrt(x);
+        }
+
+        if (!(x > 0 && x < std::numeric_limits<double>::infinity())) {
+            return (x == 0 || x == std::numeric_limits<double>::infinity()) ? x : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        // x = m 2^q, m in [2^52, 2^53)
+        uint64_t bits = std::bit_cast<uint64_t>(x);
+        uint64_t m = bits & 0x000FFFFFFFFFFFFFull;
+        int q = (int)(bits >> 52) - 1075;
+
+        if ((bits >> 52) == 0) {
+            int s = std::countl_zero(m) - 11;
+            m <<= s;
+            q = -1074 - s;
+        }
+        else {
+            m |= 0x0010000000000000ull;
+        }
+
+        if (q & 1) {
+            m <<= 1;
+            q -= 1;
+        }
+
+        // r = floor(sqrt(m 2^54)) in [2^53, 2^54), its last bit rounds; m 2^54 is never an odd square
+        uint64_t r = 0;
+        for (int k = 53; k >= 0; k--) {
+            uint64_t t = r | (1ull << k);
+
+            if (square_le(t, m >> 10, m << 54)) {
+                r = t;
+            }
+        }
+
+        uint64_t mant = (r >> 1) + (r & 1);
+        int e = (q - 54) / 2 + 1;
+
+        if (mant >> 53) {
+            mant >>= 1;
+            e++;
+        }
+
+        return std::bit_cast<double>(((uint64_t)(e + 52 + 1023) << 52) | (mant & 0x000FFFFFFFFFFFFFull));
+    }
+
+    constexpr double fma(double a, double b, double c) {
+        if (!std::is_constant_evaluated()) {
+            return std::fma(a, b, c);
+        }
+
+        double p = a * b;
+
+        if (p == 0 || !(p - p == 0) || !(c - c == 0)) {
+            return p + c;
+        }
+
+        // p + pl = a b, veltkamp split and dekker product
+        constexpr double splitter = 0x1p27 + 1;
+
+        double ta = splitter * a, ah = ta - (ta - a), al = a - ah;
+        double tb = splitter * b, bh = tb - (tb - b), bl = b - bh;
+        double pl = (((ah * bh - p) + ah * bl) + al * bh) + al * bl;
+
+        // s + sl = c + p
+        double s = c + p, sp = s - c;
+        double sl = (c - (s - sp)) + (p - sp);
+
+        // v = round_to_odd(pl + sl)
+        double v = pl + sl, vp = v - pl;
+        double vl = (pl - (v - vp)) + (sl - vp);
+
+        if (vl != 0 && (std::bit_cast<uint64_t>(v) & 1) == 0) {
+            v = std::bit_cast<double>(std::bit_cast<uint64_t>(v) + (((v > 0) == (vl > 0)) ? 1 : -1));
+        }
+
+        return s + v;
+    }
+}
+
+// generic helpers of the pade evaluation, shared by the scalar and batch headers
+namespace saspoint5_detail {
+    constexpr double fmadd(double a, double b, double c) {
+#if defined(FP_FAST_FMA)
+        return saspoint5_constexpr::fma(a, b, c);
+#else
+        return a * b + c;
+#endif
+    }
+
+    // estrin scheme over the coefficients [I, I + L) zero-padded to a power-of-two length L,
+    // xpow[k] = x^(2^k); the zero upper halves are skipped without changing the rounding
+    template <size_t I, size_t L, size_t N, size_t K>
+    constexpr double poly_estrin(const std::array<double, N>& coef, const std::array<double, K>& xpow) {
+        if constexpr (L == 1) {
+            return coef[I];
+        }
+        else if constexpr (I + L / 2 >= N) {
+            return poly_estrin<I, L / 2>(coef, xpow);
+        }
+        else {
+            return fmadd(poly_estrin<I + L / 2, L / 2>(coef, xpow), xpow[std::bit_width(L) - 2], poly_estrin<I, L / 2>(coef, xpow));
+        }
+    }
+
+    template <size_t N>
+    constexpr double poly(double x, const std::array<double, N>& coef) {
+        std::array<double, std::max<size_t>(std::bit_width(N - 1), 1)> xpow;
+
+        xpow[0] = x;
+        for (size_t k = 1; k < xpow.size(); k++) {
+            xpow[k] = xpow[k - 1] * xpow[k - 1];
+        }
+
+        return poly_estrin<0, std::bit_ceil(N)>(coef, xpow);
+    }
+
+    template <size_t N, size_t M>
+    constexpr double pade(double x, const std::array<double, N>& numer, const std::array<double, M>& denom) {
+        double sc = poly(x, numer), sd = poly(x, denom);
+
+        assert(sd >= 0.5);
+
+        return sc / sd;
+    }
+
+    template <const auto& numer, const auto& denom>
+    constexpr double pade(double x) {
+        return pade(x, numer, denom);
+    }
+
+    // coefficients of d/dx sum coef[k] x^k
+    template <size_t N>
+    constexpr std::array<double, std::max<size_t>(N - 1, 1)> poly_derivative(const std::array<double, N>& coef) {
+        std::array<double, std::max<size_t>(N - 1, 1)> dcoef{};
+
+        for (size_t k = 1; k < N; k++) {
+            dcoef[k - 1] = (double)k * coef[k];
+        }
+
+        return dcoef;
+    }
+
+    struct value_derivative {
+        double value, derivative;
+    };
 
-using namespace std;
-using namespace std::numbers;
+    // p = n / d, p' = (n' d - n d') / d^2
+    template <const auto& numer, const auto& denom>
+    value_derivative pade_derivative(double x) {
+        static constexpr auto dnumer = poly_derivative(numer), ddenom = poly_derivative(denom);
 
-double poly(double x, vector<double> coef) {
-    double s = coef[coef.size() - 1];
+        double sc = poly(x, numer), sd = poly(x, denom);
+        double dc = poly(x, dnumer), dd = poly(x, ddenom);
 
-    for (int i = coef.size() - 2; i >= 0; i--) {
-        s = s * x + coef[i];
+        assert(sd >= 0.5);
+
+        return { sc / sd, fmadd(dc, sd, -(sc * dd)) / (sd * sd) };
     }
 
-    return s;
+    struct pade_segment {
+        double offset;
+        std::span<const double> numer, denom;
+        double (*value)(double);
+        value_derivative (*derivative)(double);
+    };
+
+    // index n of the power-of-two interval (2^(e0+n-1), 2^(e0+n)] containing |x|,
+    // clamped to [0, count - 1]; nan and inf fall into the last interval
+    constexpr int pow2_segment(double x, int e0, int count) {
+        int64_t bits = std::bit_cast<int64_t>(saspoint5_constexpr::abs(x)) - 1;
+        int exponent = (int)(bits >> 52) - 1023;
+
+        return std::clamp(exponent - e0 + 1, 0, count - 1);
+    }
+}
+
+namespace saspoint5_log2 {
+    inline constexpr std::array lg = {
+        6.666666666666735130e-1,
+        3.999999999940941908e-1,
+        2.857142874366239149e-1,
+        2.222219843214978396e-1,
+        1.818357216161805012e-1,
+        1.531383769920937332e-1,
+        1.479819860511658591e-1,
+    };
+
+    inline constexpr double ivln2_hi = 1.44269504072144627571e+0, ivln2_lo = 1.67517131648865118353e-10;
 }
 
-double pade(double x, vector<double> numer, vector<double> denom) {
-    double sc = poly(x, numer), sd = poly(x, denom);
+namespace saspoint5_detail {
+    // log2(x) + shift for normal x > 0, fdlibm e_log2 reduction x = (1 + f) 2^e, 1 + f in [sqrt(1/2), sqrt(2)):
+    // the integer part e + shift is added last, so a result near 0 keeps its relative accuracy (< 1 ulp)
+    constexpr double log2_shift(double x, int shift) {
+        using namespace saspoint5_log2;
 
-    assert(sd >= 0.5);
+        uint64_t bits = std::bit_cast<uint64_t>(x);
+        uint64_t carry = ((bits & 0x000FFFFF00000000ull) + 0x00095F6400000000ull) & 0x0010000000000000ull;
 
-    return sc / sd;
+        double f = std::bit_cast<double>((bits & 0x000FFFFFFFFFFFFFull) | (carry ^ 0x3FF0000000000000ull)) - 1;
+        double e = (double)((int)(bits >> 52) - 1023 + (int)(carry >> 52) + shift);
+
+        double s = f / (2 + f), z = s * s, hfsq = 0.5 * f * f;
+        double r = s * fmadd(z, poly(z, lg), hfsq);
+
+        double hi = std::bit_cast<double>(std::bit_cast<uint64_t>(f - hfsq) & 0xFFFFFFFF00000000ull);
+        double lo = ((f - hi) - hfsq) + r;
+
+        double val_hi = hi * ivln2_hi, val_lo = fmadd(lo + hi, ivln2_lo, lo * ivln2_hi);
+        double w = e + val_hi;
+
+        val_lo += (e - w) + val_hi;
+
+        return val_lo + w;
+    }
 }
 
-double saspoint5_pdf(double x) {
-    static const vector<double> pade_plus_0_0p125_numer = {
+// Opt-in instrumentation of the scalar saspoint5_pdf/cdf/quantile, off unless SASPOINT5_INSTRUMENT is defined.
+// Each call counts a hit on its pade segment in thread-local counters; the last index of each function is
+// the branch outside the table (pdf/cdf |x| > 64, quantile exponent < -64 constant).
+// With SASPOINT5_INSTRUMENT_CYCLES = P (a power of two) every P-th call per thread is also timed by rdtsc,
+// summed per segment and binned into a log2 cycle histogram per function.
+// saspoint5_instrument_snapshot() sums all live and exited threads, saspoint5_instrument_reset() clears them.
+// When disabled, the probes expand to nothing and the snapshot is all zero; when enabled, the three
+// functions are no longer constexpr.
+namespace saspoint5_instrument {
+    enum function_id { pdf, cdf, quantile, function_count };
+
+    // pdf: 10 segments + limit, cdf: 8 segments + limit, quantile: 9 segments + constant
+    inline constexpr std::array<size_t, function_count> segment_count = { 11, 9, 10 };
+    inline constexpr size_t max_segments = 11;
+
+    // bin k counts samples of [2^(k-1), 2^k) cycles, the last bin everything above
+    inline constexpr size_t histogram_size = 24;
+
+    struct counters {
+        std::array<std::array<uint64_t, max_segments>, function_count> hits{};
+        std::array<std::array<uint64_t, max_segments>, function_count> samples{}, cycles{};
+        std::array<std::array<uint64_t, histogram_size>, function_count> histogram{};
+    };
+}
+
+#if defined(SASPOINT5_INSTRUMENT)
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#if defined(SASPOINT5_INSTRUMENT_CYCLES)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+static_assert(std::has_single_bit((unsigned int)SASPOINT5_INSTRUMENT_CYCLES), "SASPOINT5_INSTRUMENT_CYCLES must be a power of two.");
+#endif
+
+namespace saspoint5_instrument {
+    // written only by the owning thread, read by snapshot from any thread
+    struct thread_counters {
+        std::array<std::array<std::atomic<uint64_t>, max_segments>, function_count> hits, samples, cycles;
+        std::array<std::array<std::atomic<uint64_t>, histogram_size>, function_count> histogram;
+        std::array<uint64_t, function_count> calls{};
+
+        thread_counters();
+        ~thread_counters();
+    };
+
+    struct registry {
+        std::mutex lock;
+        std::vector<thread_counters*> threads;
+        counters retired;
+    };
+
+    inline registry& global_registry() {
+        static registry r;
+        return r;
+    }
+
+    // the owner is the only writer, so a relaxed load and store replaces a locked add
+    inline void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    template <size_t N>
+    void accumulate(std::array<std::array<uint64_t, N>, function_count>& sum, const std::array<std::array<std::atomic<uint64_t>, N>, function_count>& counter) {
+        for (size_t f = 0; f < function_count; f++) {
+            for (size_t i = 0; i < N; i++) {
+                sum[f][i] += counter[f][i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <size_t N>
+    void clear(std::array<std::array<std::atomic<uint64_t>, N>, function_count>& counter) {
+        for (auto& row : counter) {
+            for (std::atomic<uint64_t>& c : row) {
+                c.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline void accumulate(counters& sum, const thread_counters& counter) {
+        accumulate(sum.hits, counter.hits);
+        accumulate(sum.samples, counter.samples);
+        accumulate(sum.cycles, counter.cycles);
+        accumulate(sum.histogram, counter.histogram);
+    }
+
+    inline thread_counters::thread_counters() {
+        registry& r = global_registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+
+        r.threads.push_back(this);
+    }
+
+    // counts of an exiting thread are kept in the registry
+    inline thread_counters::~thread_counters() {
+        registry& r = global_registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+
+        accumulate(r.retired, *this);
+        erase(r.threads, this);
+    }
+
+    inline thread_counters& local() {
+        thread_local thread_counters counter;
+        return counter;
+    }
+
+    // placed at function entry; segment is set once the branch is known, -1 (nan input) is not counted
+    class probe {
+    public:
+        explicit probe(function_id function) : function_(function) {
+#if defined(SASPOINT5_INSTRUMENT_CYCLES)
+            thread_counters& counter = local();
+            start_ = ((counter.calls[function]++ & (SASPOINT5_INSTRUMENT_CYCLES - 1)) == 0) ? __rdtsc() : 0;
+#endif
+        }
+
+        probe(const probe&) = delete;
+        probe& operator=(const probe&) = delete;
+
+        ~probe() {
+            if (segment_ < 0) {
+                return;
+            }
+
+            thread_counters& counter = local();
+            bump(counter.hits[function_][segment_]);
+
+#if defined(SASPOINT5_INSTRUMENT_CYCLES)
+            if (start_ != 0) {
+                uint64_t elapsed = __rdtsc() - start_;
+
+                bump(counter.samples[function_][segment_]);
+                bump(counter.cycles[function_][segment_], elapsed);
+                bump(counter.histogram[function_][std::min<size_t>(std::bit_width(elapsed), histogram_size - 1)]);
+            }
+#endif
+        }
+
+        void hit(int segment) {
+            segment_ = segment;
+        }
+
+    private:
+        function_id function_;
+        int segment_ = -1;
+#if defined(SASPOINT5_INSTRUMENT_CYCLES)
+        uint64_t start_;
+#endif
+    };
+}
+
+#define SASPOINT5_PROBE(function) saspoint5_instrument::probe saspoint5_probe_(saspoint5_instrument::function)
+#define SASPOINT5_PROBE_HIT(segment) saspoint5_probe_.hit(segment)
+
+// the probe is not a literal type
+#define SASPOINT5_CONSTEXPR inline
+
+inline saspoint5_instrument::counters saspoint5_instrument_snapshot() {
+    using namespace saspoint5_instrument;
+
+    registry& r = global_registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+
+    counters sum = r.retired;
+    for (const thread_counters* counter : r.threads) {
+        accumulate(sum, *counter);
+    }
+
+    return sum;
+}
+
+// increments racing with the reset on other threads may survive it
+inline void saspoint5_instrument_reset() {
+    using namespace saspoint5_instrument;
+
+    registry& r = global_registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+
+    r.retired = counters{};
+    for (thread_counters* counter : r.threads) {
+        clear(counter->hits);
+        clear(counter->samples);
+        clear(counter->cycles);
+        clear(counter->histogram);
+    }
+}
+
+#else
+
+#define SASPOINT5_PROBE(function) ((void)0)
+#define SASPOINT5_PROBE_HIT(segment) ((void)0)
+
+#define SASPOINT5_CONSTEXPR constexpr
+
+inline saspoint5_instrument::counters saspoint5_instrument_snapshot() {
+    return {};
+}
+
+inline void saspoint5_instrument_reset() {}
+
+#endif
+
+namespace saspoint5_pdf_pade {
+    using namespace saspoint5_detail;
+
+    inline constexpr std::array pade_plus_0_0p125_numer = {
         6.36619772367581343076e-1,
         2.17275699713513462507e2,
         3.49063163361344578910e4,
@@ -50,7 +491,7 @@ double saspoint5_pdf(double x) {
         1.85883041942144306222e15,
         4.19828222275972713819e14,
     };
-    static const vector<double> pade_plus_0_0p125_denom = {
+    inline constexpr std::array pade_plus_0_0p125_denom = {
         1.00000000000000000000e0,
         3.41295871011779138155e2,
         5.48907134827349102297e4,
@@ -67,7 +508,7 @@ double saspoint5_pdf(double x) {
         7.45102534638640681964e15,
         3.68496090049571174527e14,
     };
-    static const vector<double> pade_plus_0p125_0p25_numer = {
+    inline constexpr std::array pade_plus_0p125_0p25_numer = {
         4.35668401768623200524e-1,
         7.12477357389655327116e0,
         4.02466317948738993787e1,
@@ -76,7 +517,7 @@ double saspoint5_pdf(double x) {
         1.26950253999694502457e1,
         -6.59304802132933325219e-1,
     };
-    static const vector<double> pade_plus_0p125_0p25_denom = {
+    inline constexpr std::array pade_plus_0p125_0p25_denom = {
         1.00000000000000000000e0,
         1.98623818041545101115e1,
         1.52856383017632616759e2,
@@ -85,7 +526,7 @@ double saspoint5_pdf(double x) {
         9.13160352749764887791e2,
         2.58872466837209126618e2,
     };
-    static const vector<double> pade_plus_0p25_0p5_numer = {
+    inline constexpr std::array pade_plus_0p25_0p5_numer = {
         2.95645445681747568732e-1,
         2.23779537590791610124e0,
         5.01302198171248036052e0,
@@ -95,7 +536,7 @@ double saspoint5_pdf(double x) {
         -7.53979800555375661516e-3,
         1.37294648777729527395e-3,
     };
-    static const vector<double> pade_plus_0p25_0p5_denom = {
+    inline constexpr std::array pade_plus_0p25_0p5_denom = {
         1.00000000000000000000e0,
         1.02879626214781666701e1,
         3.85125274509784615691e1,
@@ -103,7 +544,7 @@ double saspoint5_pdf(double x) {
         3.77100050087302476029e1,
         5.41866360740066443656e0,
     };
-    static const vector<double> pade_plus_0p5_1_numer = {
+    inline constexpr std::array pade_plus_0p5_1_numer = {
         1.70762401725206223811e-1,
         8.43343631021918972436e-1,
         1.39703819152564365627e0,
@@ -112,7 +553,7 @@ double saspoint5_pdf(double x) {
         7.35858280181579907616e-3,
         -1.03693607694266081126e-4,
     };
-    static const vector<double> pade_plus_0p5_1_denom = {
+    inline constexpr std::array pade_plus_0p5_1_denom = {
         1.00000000000000000000e0,
         6.73363440952557318819e0,
         1.74288966619209299976e1,
@@ -121,7 +562,7 @@ double saspoint5_pdf(double x) {
         3.40707211426946022041e0,
         2.80229012541729457678e-1,
     };
-    static const vector<double> pade_plus_1_2_numer = {
+    inline constexpr std::array pade_plus_1_2_numer = {
         8.61071469126041183247e-2,
         1.69689585946245345838e-1,
         1.09494833291892212033e-1,
@@ -130,7 +571,7 @@ double saspoint5_pdf(double x) {
         4.09853605772288438003e-5,
         -2.63561415158954865283e-7,
     };
-    static const vector<double> pade_plus_1_2_denom = {
+    inline constexpr std::array pade_plus_1_2_denom = {
         1.00000000000000000000e0,
         3.04082856018856244947e0,
         3.52558663323956252986e0,
@@ -139,7 +580,7 @@ double saspoint5_pdf(double x) {
         6.19453597593998871667e-2,
         2.31061984192347753499e-3,
     };
-    static const vector<double> pade_plus_2_4_numer = {
+    inline constexpr std::array pade_plus_2_4_numer = {
         3.91428580496513429479e-2,
         4.07162484034780126757e-2,
         1.43342733342753081931e-2,
@@ -148,7 +589,7 @@ double saspoint5_pdf(double x) {
         9.51545046750892356441e-7,
         -3.56598940936439037087e-9,
     };
-    static const vector<double> pade_plus_2_4_denom = {
+    inline constexpr std::array pade_plus_2_4_denom = {
         1.00000000000000000000e0,
         1.63904431617187026619e0,
         1.03812003196677309121e0,
@@ -157,7 +598,7 @@ double saspoint5_pdf(double x) {
         3.25435391589941361778e-3,
         7.01626957128181647457e-5,
     };
-    static const vector<double> pade_plus_4_8_numer = {
+    inline constexpr std::array pade_plus_4_8_numer = {
         1.65057384221262866484e-2,
         8.05429762031495873704e-3,
         1.35249234647852784985e-3,
@@ -166,7 +607,7 @@ double saspoint5_pdf(double x) {
         1.03176916111395079569e-8,
         -1.94913182592441292094e-11,
     };
-    static const vector<double> pade_plus_4_8_denom = {
+    inline constexpr std::array pade_plus_4_8_denom = {
         1.00000000000000000000e0,
         8.10113554189626079232e-1,
         2.54175325409968367580e-1,
@@ -175,7 +616,7 @@ double saspoint5_pdf(double x) {
         9.89094130526684467420e-5,
         1.07148513311070719488e-6,
     };
-    static const vector<double> pade_plus_8_16_numer = {
+    inline constexpr std::array pade_plus_8_16_numer = {
         6.60044810497290557553e-3,
         1.59342644994950292031e-3,
         1.32429706922966110874e-4,
@@ -184,7 +625,7 @@ double saspoint5_pdf(double x) {
         1.22293787679910067873e-10,
         -1.16300443044165216564e-13,
     };
-    static const vector<double> pade_plus_8_16_denom = {
+    inline constexpr std::array pade_plus_8_16_denom = {
         1.00000000000000000000e0,
         4.10446485803039594111e-1,
         6.51887342399859289520e-2,
@@ -193,7 +634,7 @@ double saspoint5_pdf(double x) {
         3.27316600311598190022e-6,
         1.78840301213102212857e-8,
     };
-    static const vector<double> pade_plus_16_32_numer = {
+    inline constexpr std::array pade_plus_16_32_numer = {
         2.54339461777955741686e-3,
         3.10069525357852579756e-4,
         1.30082682796085732756e-5,
@@ -202,7 +643,7 @@ double saspoint5_pdf(double x) {
         1.53505360463827994365e-12,
         -7.42649416356965421308e-16,
     };
-    static const vector<double> pade_plus_16_32_denom = {
+    inline constexpr std::array pade_plus_16_32_denom = {
         1.00000000000000000000e0,
         2.09203384450859785642e-1,
         1.69422626897631306130e-2,
@@ -211,7 +652,7 @@ double saspoint5_pdf(double x) {
         1.12886139474560969619e-7,
         3.14420104899170413840e-10,
     };
-    static const vector<double> pade_plus_32_64_numer = {
+    inline constexpr std::array pade_plus_32_64_numer = {
         9.55085695067883584460e-4,
         5.86125496733202756668e-5,
         1.23753971325810931282e-6,
@@ -220,7 +661,7 @@ double saspoint5_pdf(double x) {
         1.85366144680157942079e-14,
         -4.53975807317403152058e-18,
     };
-    static const vector<double> pade_plus_32_64_denom = {
+    inline constexpr std::array pade_plus_32_64_denom = {
         1.00000000000000000000e0,
         1.05980850386474826374e-1,
         4.34966042652000070674e-3,
@@ -229,14 +670,14 @@ double saspoint5_pdf(double x) {
         3.77719968378509293354e-9,
         5.33287361559571716670e-12,
     };
-    static const vector<double> pade_plus_limit_numer = {
+    inline constexpr std::array pade_plus_limit_numer = {
         1.99471140200716338970e-1,
         -1.93310094131437487158e-2,
         -8.44282614309073196195e-3,
         3.47296024282356038069e-3,
         -4.05398011689821941383e-4,
     };
-    static const vector<double> pade_plus_limit_denom = {
+    inline constexpr std::array pade_plus_limit_denom = {
         1.00000000000000000000e0,
         7.00973251258577238892e-1,
         2.66969681258835723157e-1,
@@ -244,51 +685,51 @@ double saspoint5_pdf(double x) {
         6.50130030979966274341e-3,
     };
 
-    x = abs(x);
+    inline constexpr std::array<pade_segment, 11> pade_segments = {{
+        { 0.0, pade_plus_0_0p125_numer, pade_plus_0_0p125_denom, pade<pade_plus_0_0p125_numer, pade_plus_0_0p125_denom>, pade_derivative<pade_plus_0_0p125_numer, pade_plus_0_0p125_denom> },
+        { 0.125, pade_plus_0p125_0p25_numer, pade_plus_0p125_0p25_denom, pade<pade_plus_0p125_0p25_numer, pade_plus_0p125_0p25_denom>, pade_derivative<pade_plus_0p125_0p25_numer, pade_plus_0p125_0p25_denom> },
+        { 0.25, pade_plus_0p25_0p5_numer, pade_plus_0p25_0p5_denom, pade<pade_plus_0p25_0p5_numer, pade_plus_0p25_0p5_denom>, pade_derivative<pade_plus_0p25_0p5_numer, pade_plus_0p25_0p5_denom> },
+        { 0.5, pade_plus_0p5_1_numer, pade_plus_0p5_1_denom, pade<pade_plus_0p5_1_numer, pade_plus_0p5_1_denom>, pade_derivative<pade_plus_0p5_1_numer, pade_plus_0p5_1_denom> },
+        { 1.0, pade_plus_1_2_numer, pade_plus_1_2_denom, pade<pade_plus_1_2_numer, pade_plus_1_2_denom>, pade_derivative<pade_plus_1_2_numer, pade_plus_1_2_denom> },
+        { 2.0, pade_plus_2_4_numer, pade_plus_2_4_denom, pade<pade_plus_2_4_numer, pade_plus_2_4_denom>, pade_derivative<pade_plus_2_4_numer, pade_plus_2_4_denom> },
+        { 4.0, pade_plus_4_8_numer, pade_plus_4_8_denom, pade<pade_plus_4_8_numer, pade_plus_4_8_denom>, pade_derivative<pade_plus_4_8_numer, pade_plus_4_8_denom> },
+        { 8.0, pade_plus_8_16_numer, pade_plus_8_16_denom, pade<pade_plus_8_16_numer, pade_plus_8_16_denom>, pade_derivative<pade_plus_8_16_numer, pade_plus_8_16_denom> },
+        { 16.0, pade_plus_16_32_numer, pade_plus_16_32_denom, pade<pade_plus_16_32_numer, pade_plus_16_32_denom>, pade_derivative<pade_plus_16_32_numer, pade_plus_16_32_denom> },
+        { 32.0, pade_plus_32_64_numer, pade_plus_32_64_denom, pade<pade_plus_32_64_numer, pade_plus_32_64_denom>, pade_derivative<pade_plus_32_64_numer, pade_plus_32_64_denom> },
+        { 0.0, pade_plus_limit_numer, pade_plus_limit_denom, pade<pade_plus_limit_numer, pade_plus_limit_denom>, pade_derivative<pade_plus_limit_numer, pade_plus_limit_denom> },
+    }};
+}
+
+SASPOINT5_CONSTEXPR double saspoint5_pdf(double x) {
+    using namespace saspoint5_pdf_pade;
+
+    SASPOINT5_PROBE(pdf);
+
+    x = saspoint5_constexpr::abs(x);
+
+    int index = pow2_segment(x, -3, (int)pade_segments.size());
+    const pade_segment& segment = pade_segments[index];
+
+    SASPOINT5_PROBE_HIT(index);
 
     double y;
-    if (x <= 0.125) {
-        y = pade(x, pade_plus_0_0p125_numer, pade_plus_0_0p125_denom);
-    }
-    else if (x <= 0.25) {
-        y = pade(x - 0.125, pade_plus_0p125_0p25_numer, pade_plus_0p125_0p25_denom);
-    }
-    else if (x <= 0.5) {
-        y = pade(x - 0.25, pade_plus_0p25_0p5_numer, pade_plus_0p25_0p5_denom);
-    }
-    else if (x <= 1) {
-        y = pade(x - 0.5, pade_plus_0p5_1_numer, pade_plus_0p5_1_denom);
-    }
-    else if (x <= 2) {
-        y = pade(x - 1, pade_plus_1_2_numer, pade_plus_1_2_denom);
-    }
-    else if (x <= 4) {
-        y = pade(x - 2, pade_plus_2_4_numer, pade_plus_2_4_denom);
-    }
-    else if (x <= 8) {
-        y = pade(x - 4, pade_plus_4_8_numer, pade_plus_4_8_denom);
-    }
-    else if (x <= 16) {
-        y = pade(x - 8, pade_plus_8_16_numer, pade_plus_8_16_denom);
-    }
-    else if (x <= 32) {
-        y = pade(x - 16, pade_plus_16_32_numer, pade_plus_16_32_denom);
-    }
-    else if (x <= 64) {
-        y = pade(x - 32, pade_plus_32_64_numer, pade_plus_32_64_denom);
+    if (index < (int)pade_segments.size() - 1) {
+        y = segment.value(x - segment.offset);
     }
     else {
-        double v = sqrt(x);
+        double v = saspoint5_constexpr::sqrt(x);
         double u = 1 / v;
 
-        y = pade(u, pade_plus_limit_numer, pade_plus_limit_denom) * (u * u * u);
+        y = segment.value(u) * (u * u * u);
     }
 
     return y;
 }
 
-double saspoint5_cdf(double x, bool complementary = false) {
-    static const vector<double> pade_plus_0_0p5_numer = {
+namespace saspoint5_cdf_pade {
+    using namespace saspoint5_detail;
+
+    inline constexpr std::array pade_plus_0_0p5_numer = {
         5.00000000000000000000e-1,
         1.11530082549581486148e2,
         1.18564167533523512811e4,
@@ -306,7 +747,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.36220966258718212359e11,
         1.70766655065405022702e9,
     };
-    static const vector<double> pade_plus_0_0p5_denom = {
+    inline constexpr std::array pade_plus_0_0p5_denom = {
         1.00000000000000000000e0,
         2.24333404643898143947e2,
         2.39984636687021023600e4,
@@ -324,7 +765,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.49190229409236772612e12,
         5.68752980146893975323e10,
     };
-    static const vector<double> pade_plus_0p5_1_numer = {
+    inline constexpr std::array pade_plus_0p5_1_numer = {
         3.31309550000758082456e-1,
         1.63012162307622129396e0,
         2.97763161467248770571e0,
@@ -334,7 +775,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         4.00812864075652334798e-3,
         -4.82051978765960490940e-5,
     };
-    static const vector<double> pade_plus_0p5_1_denom = {
+    inline constexpr std::array pade_plus_0p5_1_denom = {
         1.00000000000000000000e0,
         5.43565383128046471592e0,
         1.13265160672130133152e1,
@@ -343,7 +784,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.21011708389501479550e0,
         8.34618282872428849500e-2,
     };
-    static const vector<double> pade_plus_1_2_numer = {
+    inline constexpr std::array pade_plus_1_2_numer = {
         2.71280312689343248819e-1,
         7.44610837974139249205e-1,
         7.17844128359406982825e-1,
@@ -352,7 +793,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         3.06447984437786430265e-3,
         2.60407071021044908690e-5,
     };
-    static const vector<double> pade_plus_1_2_denom = {
+    inline constexpr std::array pade_plus_1_2_denom = {
         1.00000000000000000000e0,
         3.06221257507188300824e0,
         3.44827372231472308047e0,
@@ -361,7 +802,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         4.09983847731128510426e-2,
         1.04343172183467651240e-3,
     };
-    static const vector<double> pade_plus_2_4_numer = {
+    inline constexpr std::array pade_plus_2_4_numer = {
         2.13928162275383716645e-1,
         2.35139109235828185307e-1,
         9.35967515134932733243e-2,
@@ -370,7 +811,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         3.13500969261032539402e-5,
         1.17021346758965979212e-7,
     };
-    static const vector<double> pade_plus_2_4_denom = {
+    inline constexpr std::array pade_plus_2_4_denom = {
         1.00000000000000000000e0,
         1.28212183177829510267e0,
         6.17321009406850420793e-1,
@@ -379,7 +820,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         6.17774446282546623636e-4,
         7.00521050169239269819e-6,
     };
-    static const vector<double> pade_plus_4_8_numer = {
+    inline constexpr std::array pade_plus_4_8_numer = {
         1.63772802979087193656e-1,
         9.69009603942214234119e-2,
         2.08261725719828138744e-2,
@@ -388,7 +829,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.11401971145777879684e-6,
         2.25932082770588727842e-9,
     };
-    static const vector<double> pade_plus_4_8_denom = {
+    inline constexpr std::array pade_plus_4_8_denom = {
         1.00000000000000000000e0,
         6.92463563872865541733e-1,
         1.80720987166755982366e-1,
@@ -397,7 +838,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         2.93967534265875431639e-5,
         1.82706995042259549615e-7,
     };
-    static const vector<double> pade_plus_8_16_numer = {
+    inline constexpr std::array pade_plus_8_16_numer = {
         1.22610122564874280532e-1,
         3.70273222121572231593e-2,
         4.06083618461789591121e-3,
@@ -406,7 +847,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         2.87707419853226244584e-8,
         2.96850126180387702894e-11,
     };
-    static const vector<double> pade_plus_8_16_denom = {
+    inline constexpr std::array pade_plus_8_16_denom = {
         1.00000000000000000000e0,
         3.55825191301363023576e-1,
         4.77251766176046719729e-2,
@@ -415,7 +856,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.05235770624006494709e-6,
         3.35423877769913468556e-9,
     };
-    static const vector<double> pade_plus_16_32_numer = {
+    inline constexpr std::array pade_plus_16_32_numer = {
         9.03056141356415077080e-2,
         1.37568904417652631821e-2,
         7.60947271383247418831e-4,
@@ -424,7 +865,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         6.90524093915996283104e-10,
         3.58808434477817122371e-13,
     };
-    static const vector<double> pade_plus_16_32_denom = {
+    inline constexpr std::array pade_plus_16_32_denom = {
         1.00000000000000000000e0,
         1.80501347735272292079e-1,
         1.22807958286146936376e-2,
@@ -433,7 +874,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         3.53005415676201803667e-8,
         5.69883025435873921433e-11,
     };
-    static const vector<double> pade_plus_32_64_numer = {
+    inline constexpr std::array pade_plus_32_64_numer = {
         6.57333571766941474226e-2,
         5.02795551798163084224e-3,
         1.39633616037997111325e-4,
@@ -442,7 +883,7 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.60229460572297160486e-11,
         4.17711709622960498456e-15,
     };
-    static const vector<double> pade_plus_32_64_denom = {
+    inline constexpr std::array pade_plus_32_64_denom = {
         1.00000000000000000000e0,
         9.10198637347368265508e-2,
         3.12263472357578263712e-3,
@@ -451,14 +892,14 @@ double saspoint5_cdf(double x, bool complementary = false) {
         1.14970132098893394023e-9,
         9.34957119271300093120e-13,
     };
-    static const vector<double> pade_plus_limit_numer = {
+    inline constexpr std::array pade_plus_limit_numer = {
         3.98942280401432677940e-1,
         8.12222388783621449146e-2,
         1.68515703707271703934e-2,
         2.19801627205374824460e-3,
         -5.63321705854968264807e-5,
     };
-    static const vector<double> pade_plus_limit_denom = {
+    inline constexpr std::array pade_plus_limit_denom = {
         1.00000000000000000000e0,
         6.02536240902768558315e-1,
         1.99284471400121092380e-1,
@@ -466,49 +907,216 @@ double saspoint5_cdf(double x, bool complementary = false) {
         3.38545004473058881799e-3,
     };
 
+    inline constexpr std::array<pade_segment, 9> pade_segments = {{
+        { 0.0, pade_plus_0_0p5_numer, pade_plus_0_0p5_denom, pade<pade_plus_0_0p5_numer, pade_plus_0_0p5_denom>, pade_derivative<pade_plus_0_0p5_numer, pade_plus_0_0p5_denom> },
+        { 0.5, pade_plus_0p5_1_numer, pade_plus_0p5_1_denom, pade<pade_plus_0p5_1_numer, pade_plus_0p5_1_denom>, pade_derivative<pade_plus_0p5_1_numer, pade_plus_0p5_1_denom> },
+        { 1.0, pade_plus_1_2_numer, pade_plus_1_2_denom, pade<pade_plus_1_2_numer, pade_plus_1_2_denom>, pade_derivative<pade_plus_1_2_numer, pade_plus_1_2_denom> },
+        { 2.0, pade_plus_2_4_numer, pade_plus_2_4_denom, pade<pade_plus_2_4_numer, pade_plus_2_4_denom>, pade_derivative<pade_plus_2_4_numer, pade_plus_2_4_denom> },
+        { 4.0, pade_plus_4_8_numer, pade_plus_4_8_denom, pade<pade_plus_4_8_numer, pade_plus_4_8_denom>, pade_derivative<pade_plus_4_8_numer, pade_plus_4_8_denom> },
+        { 8.0, pade_plus_8_16_numer, pade_plus_8_16_denom, pade<pade_plus_8_16_numer, pade_plus_8_16_denom>, pade_derivative<pade_plus_8_16_numer, pade_plus_8_16_denom> },
+        { 16.0, pade_plus_16_32_numer, pade_plus_16_32_denom, pade<pade_plus_16_32_numer, pade_plus_16_32_denom>, pade_derivative<pade_plus_16_32_numer, pade_plus_16_32_denom> },
+        { 32.0, pade_plus_32_64_numer, pade_plus_32_64_denom, pade<pade_plus_32_64_numer, pade_plus_32_64_denom>, pade_derivative<pade_plus_32_64_numer, pade_plus_32_64_denom> },
+        { 0.0, pade_plus_limit_numer, pade_plus_limit_denom, pade<pade_plus_limit_numer, pade_plus_limit_denom>, pade_derivative<pade_plus_limit_numer, pade_plus_limit_denom> },
+    }};
+}
+
+SASPOINT5_CONSTEXPR double saspoint5_cdf(double x, bool complementary = false) {
+    using namespace saspoint5_cdf_pade;
+
+    SASPOINT5_PROBE(cdf);
+
     bool inversion = (x <= 0) ^ complementary;
 
-    x = abs(x);
+    x = saspoint5_constexpr::abs(x);
+
+    int index = pow2_segment(x, -1, (int)pade_segments.size());
+    const pade_segment& segment = pade_segments[index];
+
+    SASPOINT5_PROBE_HIT(index);
 
     double y;
-    if (x <= 0.5) {
-        y = pade(x, pade_plus_0_0p5_numer, pade_plus_0_0p5_denom);
+    if (index < (int)pade_segments.size() - 1) {
+        y = segment.value(x - segment.offset);
     }
-    else if (x <= 1) {
-        y = pade(x - 0.5, pade_plus_0p5_1_numer, pade_plus_0p5_1_denom);
+    else {
+        double v = saspoint5_constexpr::sqrt(x);
+        double u = 1 / v;
+
+        y = segment.value(u) * u;
     }
-    else if (x <= 2) {
-        y = pade(x - 1, pade_plus_1_2_numer, pade_plus_1_2_denom);
+
+    y = inversion ? y : 1 - y;
+
+    return y;
+}
+
+struct saspoint5_pdf_cdf_value {
+    double pdf, cdf, ccdf;
+};
+
+inline saspoint5_pdf_cdf_value saspoint5_pdf_cdf(double x) {
+    using namespace saspoint5_detail;
+
+    const auto& pdf_segments = saspoint5_pdf_pade::pade_segments;
+    const auto& cdf_segments = saspoint5_cdf_pade::pade_segments;
+
+    // the pdf grid splits the cdf segment [0, 0.5] at 0.125 and 0.25, and is shared above
+    static_assert(pdf_segments.size() == cdf_segments.size() + 2);
+
+    bool negative = x <= 0;
+
+    x = std::abs(x);
+
+    int index = pow2_segment(x, -3, (int)pdf_segments.size());
+    const pade_segment& pdf_segment = pdf_segments[index];
+    const pade_segment& cdf_segment = cdf_segments[std::max(index - 2, 0)];
+
+    double pdf, y;
+    if (index < (int)pdf_segments.size() - 1) {
+        pdf = pdf_segment.value(x - pdf_segment.offset);
+        y = cdf_segment.value(x - cdf_segment.offset);
     }
-    else if (x <= 4) {
-        y = pade(x - 2, pade_plus_2_4_numer, pade_plus_2_4_denom);
+    else {
+        double v = std::sqrt(x);
+        double u = 1 / v;
+
+        pdf = pdf_segment.value(u) * (u * u * u);
+        y = cdf_segment.value(u) * u;
     }
-    else if (x <= 8) {
-        y = pade(x - 4, pade_plus_4_8_numer, pade_plus_4_8_denom);
+
+    return { pdf, negative ? y : 1 - y, negative ? 1 - y : y };
+}
+
+// log(pdf), the limit branch pade(u) u^3 is split in log space where it would underflow
+inline double saspoint5_logpdf(double x) {
+    using namespace saspoint5_pdf_pade;
+
+    x = std::abs(x);
+
+    if (!(x < std::numeric_limits<double>::infinity())) {
+        return std::isnan(x) ? x : -std::numeric_limits<double>::infinity();
     }
-    else if (x <= 16) {
-        y = pade(x - 8, pade_plus_8_16_numer, pade_plus_8_16_denom);
+
+    int index = pow2_segment(x, -3, (int)pade_segments.size());
+    const pade_segment& segment = pade_segments[index];
+
+    double y;
+    if (index < (int)pade_segments.size() - 1) {
+        y = log2_shift(segment.value(x - segment.offset), 0);
     }
-    else if (x <= 32) {
-        y = pade(x - 16, pade_plus_16_32_numer, pade_plus_16_32_denom);
+    else {
+        double v = std::sqrt(x);
+        double u = 1 / v;
+
+        if (x <= 0x1p600) {
+            y = log2_shift(segment.value(u) * (u * u * u), 0);
+        }
+        else {
+            y = fmadd(-1.5, log2_shift(x, 0), log2_shift(segment.value(u), 0));
+        }
     }
-    else if (x <= 64) {
-        y = pade(x - 32, pade_plus_32_64_numer, pade_plus_32_64_denom);
+
+    y *= std::numbers::ln2;
+
+    return y;
+}
+
+// log(cdf), log(1 - y) by log1p for the side near 1
+inline double saspoint5_logcdf(double x, bool complementary = false) {
+    using namespace saspoint5_cdf_pade;
+
+    bool inversion = (x <= 0) ^ complementary;
+
+    x = std::abs(x);
+
+    int index = pow2_segment(x, -1, (int)pade_segments.size());
+    const pade_segment& segment = pade_segments[index];
+
+    double y;
+    if (index < (int)pade_segments.size() - 1) {
+        y = segment.value(x - segment.offset);
     }
     else {
-        double v = sqrt(x);
+        double v = std::sqrt(x);
         double u = 1 / v;
 
-        y = pade(u, pade_plus_limit_numer, pade_plus_limit_denom) * u;
+        y = segment.value(u) * u;
     }
 
-    y = inversion ? y : 1 - y;
+    y = inversion ? std::log(y) : std::log1p(-y);
+
+    return y;
+}
+
+inline double saspoint5_logccdf(double x) {
+    return saspoint5_logcdf(x, true);
+}
+
+// d/dx pdf, limit branch: d/dx pade(u) u^3 = -u^5 (pade'(u) u + 3 pade(u)) / 2, u = 1/sqrt(x)
+inline double saspoint5_pdf_derivative(double x) {
+    using namespace saspoint5_pdf_pade;
+
+    double sign = (x < 0) ? -1.0 : ((x > 0) ? 1.0 : 0.0);
+
+    x = std::abs(x);
+
+    int index = pow2_segment(x, -3, (int)pade_segments.size());
+    const pade_segment& segment = pade_segments[index];
+
+    double y;
+    if (index < (int)pade_segments.size() - 1) {
+        y = segment.derivative(x - segment.offset).derivative;
+    }
+    else {
+        double v = std::sqrt(x);
+        double u = 1 / v;
+
+        value_derivative p = segment.derivative(u);
+        double u2 = u * u;
+
+        y = -0.5 * (u2 * u2 * u) * fmadd(p.derivative, u, 3 * p.value);
+    }
+
+    y *= sign;
+
+    return y;
+}
+
+// d/dx log(pdf), limit branch: -u^2 (pade'(u) / pade(u) u + 3) / 2, which does not underflow
+inline double saspoint5_score(double x) {
+    using namespace saspoint5_pdf_pade;
+
+    double sign = (x < 0) ? -1.0 : ((x > 0) ? 1.0 : 0.0);
+
+    x = std::abs(x);
+
+    int index = pow2_segment(x, -3, (int)pade_segments.size());
+    const pade_segment& segment = pade_segments[index];
+
+    double y;
+    if (index < (int)pade_segments.size() - 1) {
+        value_derivative p = segment.derivative(x - segment.offset);
+
+        y = p.derivative / p.value;
+    }
+    else {
+        double v = std::sqrt(x);
+        double u = 1 / v;
+
+        value_derivative p = segment.derivative(u);
+
+        y = -0.5 * (u * u) * fmadd(p.derivative / p.value, u, 3.0);
+    }
+
+    y *= sign;
 
     return y;
 }
 
-double saspoint5_quantile(double x, bool complementary = false) {
-    static const vector<double> pade_plus_expm1_1p125_numer = {
+namespace saspoint5_quantile_pade {
+    using namespace saspoint5_detail;
+
+    inline constexpr std::array pade_plus_expm1_1p125_numer = {
         0.00000000000000000000e0,
         1.36099130643975127045e-1,
         2.19634434498311523885e1,
@@ -524,7 +1132,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         1.49986408149520127078e10,
         -6.17325587219357123900e8,
     };
-    static const vector<double> pade_plus_expm1_1p125_denom = {
+    inline constexpr std::array pade_plus_expm1_1p125_denom = {
         1.00000000000000000000e0,
         1.63111146753825227716e2,
         1.27864461509685444043e4,
@@ -539,7 +1147,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         5.43552396263989180433e11,
         9.57434915768660935004e10,
     };
-    static const vector<double> pade_plus_expm1p125_1p25_numer = {
+    inline constexpr std::array pade_plus_expm1p125_1p25_numer = {
         1.46698650748920243698e-2,
         3.58380131788385557227e-1,
         3.39153750029553194566e0,
@@ -549,7 +1157,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         2.77679052294606319767e0,
         -7.76665288232972435969e-2,
     };
-    static const vector<double> pade_plus_expm1p125_1p25_denom = {
+    inline constexpr std::array pade_plus_expm1p125_1p25_denom = {
         1.00000000000000000000e0,
         1.72584280323876188464e1,
         1.11983518800147654866e2,
@@ -558,7 +1166,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         1.29874252720714897530e2,
         2.08740114519610102248e1,
     };
-    static const vector<double> pade_plus_expm1p25_1p5_numer = {
+    inline constexpr std::array pade_plus_expm1p25_1p5_numer = {
         2.69627866689346445458e-2,
         3.23091180507445216811e-1,
         1.42164019533549860681e0,
@@ -568,7 +1176,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         -2.55816250186301841152e-2,
         3.02683750470398342224e-3,
     };
-    static const vector<double> pade_plus_expm1p25_1p5_denom = {
+    inline constexpr std::array pade_plus_expm1p25_1p5_denom = {
         1.00000000000000000000e0,
         8.55049920135376003042e0,
         2.48726119139047911316e1,
@@ -576,7 +1184,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         9.88212916161823866098e0,
         1.39749417956251951564e0,
     };
-    static const vector<double> pade_plus_expm1p5_2_numer = {
+    inline constexpr std::array pade_plus_expm1p5_2_numer = {
         4.79518653373241051274e-2,
         3.81837125793765918564e-1,
         1.13370353708146321188e0,
@@ -587,7 +1195,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         1.73314614571009160225e-3,
         -3.63491208733876986098e-5,
     };
-    static const vector<double> pade_plus_expm1p5_2_denom = {
+    inline constexpr std::array pade_plus_expm1p5_2_denom = {
         1.00000000000000000000e0,
         6.36954463000253710936e0,
         1.40601897306833147611e1,
@@ -597,7 +1205,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         1.12508482637488861060e-1,
         5.18503975949799718538e-3,
     };
-    static const vector<double> pade_plus_expm2_4_numer = {
+    inline constexpr std::array pade_plus_expm2_4_numer = {
         8.02395484493329835881e-2,
         2.46132933068351274622e-1,
         2.81820176867119231101e-1,
@@ -609,7 +1217,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         -2.06151396745690348445e-7,
         6.77986548138011345849e-9,
     };
-    static const vector<double> pade_plus_expm2_4_denom = {
+    inline constexpr std::array pade_plus_expm2_4_denom = {
         1.00000000000000000000e0,
         2.39244329037830026691e0,
         2.12683465416376620896e0,
@@ -619,7 +1227,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         2.28216286216537879937e-3,
         1.04195690531437767679e-4,
     };
-    static const vector<double> pade_plus_expm4_8_numer = {
+    inline constexpr std::array pade_plus_expm4_8_numer = {
         1.39293493266195561875e-1,
         1.26741380938661691592e-1,
         4.31117040307200265931e-2,
@@ -630,7 +1238,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         9.63513655399980075083e-8,
         -6.40223609013005302318e-11,
     };
-    static const vector<double> pade_plus_expm4_8_denom = {
+    inline constexpr std::array pade_plus_expm4_8_denom = {
         1.00000000000000000000e0,
         8.11234548272888947555e-1,
         2.63525516991753831892e-1,
@@ -640,7 +1248,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         2.02377681998442384863e-5,
         5.79823311154876056655e-7,
     };
-    static const vector<double> pade_plus_expm8_16_numer = {
+    inline constexpr std::array pade_plus_expm8_16_numer = {
         1.57911660613037760235e-1,
         5.59740955695099219682e-2,
         8.92895854008560399142e-3,
@@ -651,7 +1259,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         7.62193242864380357931e-10,
         -7.82035413331699873450e-14,
     };
-    static const vector<double> pade_plus_expm8_16_denom = {
+    inline constexpr std::array pade_plus_expm8_16_denom = {
         1.00000000000000000000e0,
         3.49007782566002620811e-1,
         5.65303702876260444572e-2,
@@ -661,7 +1269,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         4.08512152326482573624e-7,
         4.72959615756470826429e-9,
     };
-    static const vector<double> pade_plus_expm16_32_numer = {
+    inline constexpr std::array pade_plus_expm16_32_numer = {
         1.59150086070234563099e-1,
         6.07144002506911115092e-2,
         1.10026443723891740392e-2,
@@ -673,7 +1281,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         1.05110361316230054467e-10,
         1.48083450629432857655e-18,
     };
-    static const vector<double> pade_plus_expm16_32_denom = {
+    inline constexpr std::array pade_plus_expm16_32_denom = {
         1.00000000000000000000e0,
         3.81470315977341203351e-1,
         6.91330250512167919573e-2,
@@ -684,7 +1292,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         4.04840254888235877998e-8,
         6.60429636407045050112e-10,
     };
-    static const vector<double> pade_plus_expm32_64_numer = {
+    inline constexpr std::array pade_plus_expm32_64_numer = {
         1.59154943017783026201e-1,
         6.91506515614472069475e-2,
         1.44590186111155933843e-2,
@@ -695,7 +1303,7 @@ double saspoint5_quantile(double x, bool complementary = false) {
         3.50107118687544980820e-8,
         -1.47102592933729597720e-22,
     };
-    static const vector<double> pade_plus_expm32_64_denom = {
+    inline constexpr std::array pade_plus_expm32_64_denom = {
         1.00000000000000000000e0,
         4.34486357752330500669e-1,
         9.08486933075320995164e-2,
@@ -706,49 +1314,56 @@ double saspoint5_quantile(double x, bool complementary = false) {
         2.19978790407451988423e-7,
     };
 
-    if (x > 0.5) {
-        return -saspoint5_quantile(1 - x, complementary);
+    inline constexpr std::array<pade_segment, 9> pade_segments = {{
+        { 0.0, pade_plus_expm1_1p125_numer, pade_plus_expm1_1p125_denom, pade<pade_plus_expm1_1p125_numer, pade_plus_expm1_1p125_denom>, pade_derivative<pade_plus_expm1_1p125_numer, pade_plus_expm1_1p125_denom> },
+        { 0.125, pade_plus_expm1p125_1p25_numer, pade_plus_expm1p125_1p25_denom, pade<pade_plus_expm1p125_1p25_numer, pade_plus_expm1p125_1p25_denom>, pade_derivative<pade_plus_expm1p125_1p25_numer, pade_plus_expm1p125_1p25_denom> },
+        { 0.25, pade_plus_expm1p25_1p5_numer, pade_plus_expm1p25_1p5_denom, pade<pade_plus_expm1p25_1p5_numer, pade_plus_expm1p25_1p5_denom>, pade_derivative<pade_plus_expm1p25_1p5_numer, pade_plus_expm1p25_1p5_denom> },
+        { 0.5, pade_plus_expm1p5_2_numer, pade_plus_expm1p5_2_denom, pade<pade_plus_expm1p5_2_numer, pade_plus_expm1p5_2_denom>, pade_derivative<pade_plus_expm1p5_2_numer, pade_plus_expm1p5_2_denom> },
+        { 0.0, pade_plus_expm2_4_numer, pade_plus_expm2_4_denom, pade<pade_plus_expm2_4_numer, pade_plus_expm2_4_denom>, pade_derivative<pade_plus_expm2_4_numer, pade_plus_expm2_4_denom> },
+        { 0.0, pade_plus_expm4_8_numer, pade_plus_expm4_8_denom, pade<pade_plus_expm4_8_numer, pade_plus_expm4_8_denom>, pade_derivative<pade_plus_expm4_8_numer, pade_plus_expm4_8_denom> },
+        { 0.0, pade_plus_expm8_16_numer, pade_plus_expm8_16_denom, pade<pade_plus_expm8_16_numer, pade_plus_expm8_16_denom>, pade_derivative<pade_plus_expm8_16_numer, pade_plus_expm8_16_denom> },
+        { 0.0, pade_plus_expm16_32_numer, pade_plus_expm16_32_denom, pade<pade_plus_expm16_32_numer, pade_plus_expm16_32_denom>, pade_derivative<pade_plus_expm16_32_numer, pade_plus_expm16_32_denom> },
+        { 0.0, pade_plus_expm32_64_numer, pade_plus_expm32_64_denom, pade<pade_plus_expm32_64_numer, pade_plus_expm32_64_denom>, pade_derivative<pade_plus_expm32_64_numer, pade_plus_expm32_64_denom> },
+    }};
+}
+
+SASPOINT5_CONSTEXPR double saspoint5_quantile(double x, bool complementary = false) {
+    using namespace saspoint5_quantile_pade;
+
+    SASPOINT5_PROBE(quantile);
+
+    // quantile(x) = -quantile(1 - x)
+    bool flip = x > 0.5;
+    x = flip ? 1 - x : x;
+    complementary ^= flip;
+
+    if (!(x >= 0)) {
+        return std::numeric_limits<double>::quiet_NaN();
     }
 
     double v;
-    int exponent = ilogb(x);
+    int exponent = (int)(std::bit_cast<uint64_t>(saspoint5_constexpr::abs(x)) >> 52) - 1023;
 
-    if (exponent >= -2) {
-        double u = -log2(ldexp(x, 1));
+    if (exponent >= -64) {
+        // -log2(x * 2^k), k = 1 for ilogb(x) >= -2, k = 2, 4, ..., 32 for ilogb(x) >= -4, -8, ..., -64
+        int m = (exponent >= -2) ? 1 : std::bit_width((unsigned int)(-exponent - 1));
+        double u = -log2_shift(x, 1 << (m - 1));
 
-        if (u <= 0.125) {
-            v = pade(u, pade_plus_expm1_1p125_numer, pade_plus_expm1_1p125_denom);
-        }
-        else if (u <= 0.25) {
-            v = pade(u - 0.125, pade_plus_expm1p125_1p25_numer, pade_plus_expm1p125_1p25_denom);
-        }
-        else if (u <= 0.5) {
-            v = pade(u - 0.25, pade_plus_expm1p25_1p5_numer, pade_plus_expm1p25_1p5_denom);
-        }
-        else {
-            v = pade(u - 0.5, pade_plus_expm1p5_2_numer, pade_plus_expm1p5_2_denom);
-        }
-    }
-    else if (exponent >= -4) {
-        v = pade(-log2(ldexp(x, 2)), pade_plus_expm2_4_numer, pade_plus_expm2_4_denom);
-    }
-    else if (exponent >= -8) {
-        v = pade(-log2(ldexp(x, 4)), pade_plus_expm4_8_numer, pade_plus_expm4_8_denom);
-    }
-    else if (exponent >= -16) {
-        v = pade(-log2(ldexp(x, 8)), pade_plus_expm8_16_numer, pade_plus_expm8_16_denom);
-    }
-    else if (exponent >= -32) {
-        v = pade(-log2(ldexp(x, 16)), pade_plus_expm16_32_numer, pade_plus_expm16_32_denom);
-    }
-    else if (exponent >= -64) {
-        v = pade(-log2(ldexp(x, 32)), pade_plus_expm32_64_numer, pade_plus_expm32_64_denom);
+        int index = (m > 1) ? (m + 2) : pow2_segment(u, -3, 4);
+        const pade_segment& segment = pade_segments[index];
+
+        SASPOINT5_PROBE_HIT(index);
+
+        v = segment.value(u - segment.offset);
     }
     else {
-        v = ldexp(1 / pi, -1);
+        SASPOINT5_PROBE_HIT((int)pade_segments.size());
+
+        v = 0.5 / std::numbers::pi;
     }
 
-    double y = v / (x * x);
+    // v / 0 = inf, which a constant expression may not compute by division
+    double y = (std::is_constant_evaluated() && x * x == 0) ? std::numeric_limits<double>::infinity() : v / (x * x);
 
     y = complementary ? y : -y;
 
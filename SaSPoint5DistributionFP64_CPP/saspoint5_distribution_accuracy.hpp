@@ -0,0 +1,300 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Accuracy evaluation against binary reference datasets.
+// A reference file is a saspoint5_reference_header followed by records of x and the expected value
+// as a double-double (hi + lo), written by SaSPoint5DistributionReference.cs from the DoubleDouble library.
+// saspoint5_reference_file maps the file read-only; saspoint5_evaluate_accuracy streams the records
+// through the batch kernels in the chunks of saspoint5_parallel::for_each_chunk and reports the relative
+// error per pade segment, indexed as in saspoint5_instrument (the last index is the branch outside the table).
+// File errors throw runtime_error.
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "saspoint5_distribution_parallel.hpp"
+
+enum class saspoint5_reference_function : uint32_t {
+    pdf, cdf, ccdf, quantile, cquantile
+};
+
+struct saspoint5_reference_header {
+    static constexpr std::array<char, 8> magic_value = { 'S', 'A', 'S', 'P', 'T', '5', 'R', 'F' };
+    static constexpr uint32_t version_value = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    saspoint5_reference_function function;
+    uint64_t count;
+    uint64_t reserved;
+};
+
+struct saspoint5_reference_record {
+    double x, expected_hi, expected_lo;
+};
+
+static_assert(sizeof(saspoint5_reference_header) == 32);
+static_assert(sizeof(saspoint5_reference_record) == 24);
+
+struct saspoint5_segment_accuracy {
+    size_t count;
+    double max_error, x_at_max;
+    // relative error percentiles
+    double p50, p99, p999;
+};
+
+class saspoint5_reference_file {
+public:
+    explicit saspoint5_reference_file(const std::string& filepath) {
+#if defined(_WIN32)
+        file_ = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open " + filepath + ".");
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file_, &size);
+        size_ = (size_t)size.QuadPart;
+
+        mapping_ = (size_ > 0) ? CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        data_ = (mapping_ != nullptr) ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+#else
+        fd_ = open(filepath.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open " + filepath + ".");
+        }
+
+        struct stat st;
+        fstat(fd_, &st);
+        size_ = (size_t)st.st_size;
+
+        if (size_ > 0) {
+            data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            data_ = (data_ != MAP_FAILED) ? data_ : nullptr;
+        }
+#endif
+
+        if (data_ == nullptr || size_ < sizeof(saspoint5_reference_header)) {
+            release();
+            throw std::runtime_error("Failed to map " + filepath + ".");
+        }
+
+        const saspoint5_reference_header& h = header();
+
+        if (h.magic != saspoint5_reference_header::magic_value || h.version != saspoint5_reference_header::version_value ||
+            (uint32_t)h.function > (uint32_t)saspoint5_reference_function::cquantile ||
+            h.count > (size_ - sizeof(saspoint5_reference_header)) / sizeof(saspoint5_reference_record)) {
+
+            release();
+            throw std::runtime_error("Invalid reference file " + filepath + ".");
+        }
+    }
+
+    saspoint5_reference_file(const saspoint5_reference_file&) = delete;
+    saspoint5_reference_file& operator=(const saspoint5_reference_file&) = delete;
+
+    ~saspoint5_reference_file() {
+        release();
+    }
+
+    const saspoint5_reference_header& header() const {
+        return *static_cast<const saspoint5_reference_header*>(data_);
+    }
+
+    std::span<const saspoint5_reference_record> records() const {
+        const char* first = static_cast<const char*>(data_) + sizeof(saspoint5_reference_header);
+
+        return { reinterpret_cast<const saspoint5_reference_record*>(first), (size_t)header().count };
+    }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE, mapping_ = nullptr;
+
+    void release() {
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+
+        data_ = nullptr, mapping_ = nullptr, file_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    int fd_ = -1;
+
+    void release() {
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+
+        data_ = nullptr, fd_ = -1;
+    }
+#endif
+};
+
+namespace saspoint5_accuracy {
+    using namespace saspoint5_detail;
+
+    inline size_t segment_count(saspoint5_reference_function function) {
+        switch (function) {
+        case saspoint5_reference_function::pdf:
+            return saspoint5_instrument::segment_count[saspoint5_instrument::pdf];
+        case saspoint5_reference_function::cdf:
+        case saspoint5_reference_function::ccdf:
+            return saspoint5_instrument::segment_count[saspoint5_instrument::cdf];
+        default:
+            return saspoint5_instrument::segment_count[saspoint5_instrument::quantile];
+        }
+    }
+
+    // the segment selection of saspoint5_pdf, saspoint5_cdf and saspoint5_quantile
+    inline int segment_index(saspoint5_reference_function function, double x) {
+        int count = (int)segment_count(function);
+
+        switch (function) {
+        case saspoint5_reference_function::pdf:
+            return pow2_segment(x, -3, count);
+        case saspoint5_reference_function::cdf:
+        case saspoint5_reference_function::ccdf:
+            return pow2_segment(x, -1, count);
+        default:
+            break;
+        }
+
+        x = (x > 0.5) ? 1 - x : x;
+
+        int exponent = (int)(std::bit_cast<uint64_t>(std::abs(x)) >> 52) - 1023;
+        if (exponent < -64) {
+            return count - 1;
+        }
+
+        int m = (exponent >= -2) ? 1 : std::bit_width((unsigned int)(-exponent - 1));
+
+        return (m > 1) ? (m + 2) : pow2_segment(-log2_shift(x, 1), -3, 4);
+    }
+
+    inline void evaluate(saspoint5_reference_function function, std::span<const double> x, std::span<double> y) {
+        switch (function) {
+        case saspoint5_reference_function::pdf:
+            saspoint5_pdf(x, y);
+            break;
+        case saspoint5_reference_function::cdf:
+        case saspoint5_reference_function::ccdf:
+            saspoint5_cdf(x, y, function == saspoint5_reference_function::ccdf);
+            break;
+        default:
+            saspoint5_quantile(x, y, function == saspoint5_reference_function::cquantile);
+            break;
+        }
+    }
+
+    // |y - (hi + lo)| / |hi + lo|, y - hi is exact when y is within a factor 2 of hi
+    inline double relative_error(double y, double hi, double lo) {
+        if (y == hi && lo == 0) {
+            return 0;
+        }
+        if (hi == 0 || !std::isfinite(hi)) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        return std::abs((y - hi) - lo) / std::abs(hi);
+    }
+
+    // q-quantile of v by selection, v is reordered
+    inline double percentile(std::vector<double>& v, double q) {
+        if (v.empty()) {
+            return 0;
+        }
+
+        auto k = v.begin() + (ptrdiff_t)std::min(v.size() - 1, (size_t)(q * (double)v.size()));
+        std::nth_element(v.begin(), k, v.end());
+
+        return *k;
+    }
+}
+
+// relative error per segment of the function the reference was written for
+inline std::vector<saspoint5_segment_accuracy> saspoint5_evaluate_accuracy(
+    saspoint5_reference_function function, std::span<const saspoint5_reference_record> records) {
+
+    using namespace saspoint5_accuracy;
+
+    size_t n = records.size();
+
+    std::vector<double> errors(n);
+    std::vector<uint8_t> segments(n);
+
+    saspoint5_parallel::for_each_chunk(n, [&](size_t begin, size_t end) {
+        std::array<double, saspoint5_parallel::chunk_size> x, y;
+        size_t rows = end - begin;
+
+        for (size_t i = 0; i < rows; i++) {
+            x[i] = records[begin + i].x;
+        }
+
+        evaluate(function, std::span(x.data(), rows), std::span(y.data(), rows));
+
+        for (size_t i = 0; i < rows; i++) {
+            const saspoint5_reference_record& record = records[begin + i];
+
+            errors[begin + i] = relative_error(y[i], record.expected_hi, record.expected_lo);
+            segments[begin + i] = (uint8_t)segment_index(function, record.x);
+        }
+    });
+
+    std::vector<saspoint5_segment_accuracy> accuracy(segment_count(function));
+    std::vector<std::vector<double>> segment_errors(accuracy.size());
+
+    for (size_t i = 0; i < n; i++) {
+        saspoint5_segment_accuracy& a = accuracy[segments[i]];
+
+        if (a.count == 0 || errors[i] > a.max_error) {
+            a.max_error = errors[i];
+            a.x_at_max = records[i].x;
+        }
+
+        a.count++;
+        segment_errors[segments[i]].push_back(errors[i]);
+    }
+
+    for (size_t s = 0; s < accuracy.size(); s++) {
+        accuracy[s].p50 = percentile(segment_errors[s], 0.5);
+        accuracy[s].p99 = percentile(segment_errors[s], 0.99);
+        accuracy[s].p999 = percentile(segment_errors[s], 0.999);
+    }
+
+    return accuracy;
+}
+
+inline std::vector<saspoint5_segment_accuracy> saspoint5_evaluate_accuracy(const saspoint5_reference_file& reference) {
+    return saspoint5_evaluate_accuracy(reference.header().function, reference.records());
+}
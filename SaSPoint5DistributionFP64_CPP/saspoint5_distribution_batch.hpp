@@ -0,0 +1,1191 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Batch evaluation of saspoint5_pdf/cdf/quantile over contiguous arrays.
+// With AVX-512F or AVX2 enabled at compile time, each lane selects its pade segment
+// by mask counting and gathers the coefficients from zero-padded, segment-interleaved tables.
+// Zero padding of the tables does not change the estrin result and the kernels use fma
+// exactly when the scalar fmadd does (__FMA__ / FP_FAST_FMA), so without SASPOINT5_DISPATCH
+// the output is bit-identical to the scalar functions.
+//
+// With SASPOINT5_DISPATCH defined (GCC, x86), the double span functions of this header
+// (pdf, cdf, quantile, pdf_cdf, logpdf, loglikelihood, pdf_derivative, score) and the *_sorted
+// functions instead pick the AVX-512F, AVX2+FMA or scalar kernels at run time by cpuid, on first call.
+// The environment variable SASPOINT5_ISA (scalar, avx2, avx512) or saspoint5_set_isa forces a path.
+// Both vector paths use fma and pad the array tail to a full vector, so every dispatched function
+// gives the same bits on either of them for any length. The scalar path follows the fmadd of the build;
+// in a build without fma the vector paths therefore differ from the scalar functions by a few ulp.
+// saspoint5_fast and the float functions are not dispatched and follow the compile flags.
+// Meant for baseline x86-64 builds; the kernel templates take vector arguments outside their target,
+// so GCC prints a note on the 64-byte vector parameter abi, which does not apply (the kernels are only
+// ever inlined into the target wrappers). Build with -Wno-psabi:
+//   g++ -std=c++20 -O3 -DSASPOINT5_DISPATCH -Wno-psabi ...
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "saspoint5_distribution.hpp"
+#include "saspoint5_distribution_pool.hpp"
+
+#if defined(__AVX2__) || defined(__AVX512F__) || defined(SASPOINT5_DISPATCH)
+#include <immintrin.h>
+#endif
+
+#if defined(SASPOINT5_DISPATCH)
+#if !defined(__GNUC__) || defined(__clang__) || !(defined(__x86_64__) || defined(__i386__))
+#error "SASPOINT5_DISPATCH requires GCC on x86."
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+#endif
+
+namespace saspoint5_simd {
+    template <size_t S, size_t N, size_t M, class T = double>
+    struct pade_table {
+        std::array<T, S> offset;
+        std::array<std::array<T, S>, N> numer;
+        std::array<std::array<T, S>, M> denom;
+        size_t numer_tail, denom_tail;
+    };
+
+    template <class Segment, size_t S>
+    constexpr size_t max_numer_size(const std::array<Segment, S>& segments, size_t start = 0) {
+        size_t n = 0;
+
+        for (size_t s = start; s < S; s++) {
+            n = std::max(n, segments[s].numer.size());
+        }
+
+        return n;
+    }
+
+    template <class Segment, size_t S>
+    constexpr size_t max_denom_size(const std::array<Segment, S>& segments, size_t start = 0) {
+        size_t n = 0;
+
+        for (size_t s = start; s < S; s++) {
+            n = std::max(n, segments[s].denom.size());
+        }
+
+        return n;
+    }
+
+    // order 1 stores the coefficients of the derivative polynomials
+    template <size_t N, size_t M, class Segment, size_t S>
+    constexpr auto build_pade_table(const std::array<Segment, S>& segments, size_t order = 0) {
+        using T = decltype(Segment::offset);
+
+        pade_table<S, N, M, T> table{};
+
+        for (size_t s = 0; s < S; s++) {
+            table.offset[s] = segments[s].offset;
+
+            for (size_t i = order; i < segments[s].numer.size(); i++) {
+                table.numer[i - order][s] = (T)(order > 0 ? (double)i : 1.0) * segments[s].numer[i];
+            }
+            for (size_t i = order; i < segments[s].denom.size(); i++) {
+                table.denom[i - order][s] = (T)(order > 0 ? (double)i : 1.0) * segments[s].denom[i];
+            }
+        }
+
+        table.numer_tail = std::max<size_t>(max_numer_size(segments, 1) - order, 1);
+        table.denom_tail = std::max<size_t>(max_denom_size(segments, 1) - order, 1);
+
+        return table;
+    }
+
+    namespace pdf {
+        inline constexpr std::array bounds = {
+            0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0
+        };
+
+        using saspoint5_pdf_pade::pade_segments;
+
+        inline constexpr auto table = build_pade_table<max_numer_size(pade_segments), max_denom_size(pade_segments)>(pade_segments);
+        inline constexpr auto dtable = build_pade_table<max_numer_size(pade_segments) - 1, max_denom_size(pade_segments) - 1>(pade_segments, 1);
+    }
+
+    namespace cdf {
+        inline constexpr std::array bounds = {
+            0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0
+        };
+
+        using saspoint5_cdf_pade::pade_segments;
+
+        inline constexpr auto table = build_pade_table<max_numer_size(pade_segments), max_denom_size(pade_segments)>(pade_segments);
+    }
+
+    namespace quantile {
+        // segments 0-3: -log2(2x) in [0, 2], split at 0.125, 0.25, 0.5
+        // segments 4-8: -log2(x * 2^k), k = 2, 4, 8, 16, 32 for ilogb(x) >= -4, -8, -16, -32, -64
+        inline constexpr std::array bounds = {
+            0.125, 0.25, 0.5
+        };
+
+        inline constexpr std::array exponents = {
+            -64.0, -32.0, -16.0, -8.0, -4.0, -2.0
+        };
+
+        inline constexpr std::array shifts = {
+            0.0, 32.0, 16.0, 8.0, 4.0, 2.0, 1.0
+        };
+
+        using saspoint5_quantile_pade::pade_segments;
+
+        inline constexpr auto table = build_pade_table<max_numer_size(pade_segments), max_denom_size(pade_segments)>(pade_segments);
+    }
+
+#if defined(__AVX512F__) || defined(SASPOINT5_DISPATCH)
+#if defined(SASPOINT5_DISPATCH)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+    struct avx512 {
+        using vdouble = __m512d;
+        using vmask = __mmask8;
+        using vindex = __m256i;
+
+        static constexpr size_t lanes = 8;
+
+        static vdouble load(const double* p) { return _mm512_loadu_pd(p); }
+        static void store(double* p, vdouble v) { _mm512_storeu_pd(p, v); }
+        static vdouble set1(double v) { return _mm512_set1_pd(v); }
+
+        static vdouble add(vdouble a, vdouble b) { return _mm512_add_pd(a, b); }
+        static vdouble sub(vdouble a, vdouble b) { return _mm512_sub_pd(a, b); }
+        static vdouble mul(vdouble a, vdouble b) { return _mm512_mul_pd(a, b); }
+        static vdouble div(vdouble a, vdouble b) { return _mm512_div_pd(a, b); }
+        static vdouble sqrt(vdouble v) { return _mm512_maskz_sqrt_pd(0xFF, v); }
+        static vdouble abs(vdouble v) { return _mm512_abs_pd(v); }
+        static vdouble floor(vdouble v) { return _mm512_maskz_roundscale_pd(0xFF, v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+        static vdouble neg(vdouble v) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(v), _mm512_set1_epi64(INT64_MIN))); }
+
+        static vdouble bits(uint64_t v) { return _mm512_castsi512_pd(_mm512_set1_epi64((int64_t)v)); }
+        static vdouble band(vdouble a, vdouble b) { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b))); }
+        static vdouble bor(vdouble a, vdouble b) { return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b))); }
+        static vdouble bxor(vdouble a, vdouble b) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b))); }
+        static vdouble iadd(vdouble a, vdouble b) { return _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(a), _mm512_castpd_si512(b))); }
+
+        static vdouble muladd(vdouble a, vdouble b, vdouble c) {
+#if defined(__FMA__) || defined(SASPOINT5_DISPATCH)
+            return _mm512_fmadd_pd(a, b, c);
+#else
+            return _mm512_add_pd(_mm512_mul_pd(a, b), c);
+#endif
+        }
+
+        static vmask gt(vdouble a, vdouble b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+        static vmask ge(vdouble a, vdouble b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+        static vmask le(vdouble a, vdouble b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+        static vmask eq(vdouble a, vdouble b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+        static vmask bnot(vmask m) { return (vmask)~m; }
+        static bool any(vmask m) { return m != 0; }
+
+        static vdouble select(vmask m, vdouble a, vdouble b) { return _mm512_mask_blend_pd(m, b, a); }
+        static vdouble count(vdouble c, vmask m) { return _mm512_mask_add_pd(c, m, c, _mm512_set1_pd(1.0)); }
+
+        static vindex index(vdouble c) { return _mm512_maskz_cvttpd_epi32(0xFF, c); }
+        static vdouble gather(const double* base, vindex idx) { return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, base, 8); }
+
+        static vdouble exponent(vdouble v) {
+            __m512i e = _mm512_maskz_srli_epi64(0xFF, _mm512_castpd_si512(_mm512_abs_pd(v)), 52);
+            __m512d d = _mm512_castsi512_pd(_mm512_or_si512(e, _mm512_castpd_si512(_mm512_set1_pd(0x1p52))));
+
+            return _mm512_sub_pd(d, _mm512_set1_pd(0x1p52 + 1023));
+        }
+    };
+#if defined(SASPOINT5_DISPATCH)
+#pragma GCC pop_options
+#endif
+#endif
+
+#if defined(__AVX2__) || defined(SASPOINT5_DISPATCH)
+#if defined(SASPOINT5_DISPATCH)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+    struct avx2 {
+        using vdouble = __m256d;
+        using vmask = __m256d;
+        using vindex = __m128i;
+
+        static constexpr size_t lanes = 4;
+
+        static vdouble load(const double* p) { return _mm256_loadu_pd(p); }
+        static void store(double* p, vdouble v) { _mm256_storeu_pd(p, v); }
+        static vdouble set1(double v) { return _mm256_set1_pd(v); }
+
+        static vdouble add(vdouble a, vdouble b) { return _mm256_add_pd(a, b); }
+        static vdouble sub(vdouble a, vdouble b) { return _mm256_sub_pd(a, b); }
+        static vdouble mul(vdouble a, vdouble b) { return _mm256_mul_pd(a, b); }
+        static vdouble div(vdouble a, vdouble b) { return _mm256_div_pd(a, b); }
+        static vdouble sqrt(vdouble v) { return _mm256_sqrt_pd(v); }
+        static vdouble abs(vdouble v) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v); }
+        static vdouble floor(vdouble v) { return _mm256_floor_pd(v); }
+        static vdouble neg(vdouble v) { return _mm256_xor_pd(_mm256_set1_pd(-0.0), v); }
+
+        static vdouble bits(uint64_t v) { return _mm256_castsi256_pd(_mm256_set1_epi64x((int64_t)v)); }
+        static vdouble band(vdouble a, vdouble b) { return _mm256_and_pd(a, b); }
+        static vdouble bor(vdouble a, vdouble b) { return _mm256_or_pd(a, b); }
+        static vdouble bxor(vdouble a, vdouble b) { return _mm256_xor_pd(a, b); }
+        static vdouble iadd(vdouble a, vdouble b) { return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(a), _mm256_castpd_si256(b))); }
+
+        static vdouble muladd(vdouble a, vdouble b, vdouble c) {
+#if defined(__FMA__) || defined(SASPOINT5_DISPATCH)
+            return _mm256_fmadd_pd(a, b, c);
+#else
+            return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+        }
+
+        static vmask gt(vdouble a, vdouble b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static vmask ge(vdouble a, vdouble b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+        static vmask le(vdouble a, vdouble b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+        static vmask eq(vdouble a, vdouble b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+        static vmask bnot(vmask m) { return _mm256_xor_pd(m, _mm256_castsi256_pd(_mm256_set1_epi64x(-1))); }
+        static bool any(vmask m) { return _mm256_movemask_pd(m) != 0; }
+
+        static vdouble select(vmask m, vdouble a, vdouble b) { return _mm256_blendv_pd(b, a, m); }
+        static vdouble count(vdouble c, vmask m) { return _mm256_add_pd(c, _mm256_and_pd(m, _mm256_set1_pd(1.0))); }
+
+        static vindex index(vdouble c) { return _mm256_cvttpd_epi32(c); }
+        static vdouble gather(const double* base, vindex idx) { return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8); }
+
+        static vdouble exponent(vdouble v) {
+            __m256i e = _mm256_srli_epi64(_mm256_castpd_si256(abs(v)), 52);
+            __m256d d = _mm256_castsi256_pd(_mm256_or_si256(e, _mm256_castpd_si256(_mm256_set1_pd(0x1p52))));
+
+            return _mm256_sub_pd(d, _mm256_set1_pd(0x1p52 + 1023));
+        }
+    };
+#if defined(SASPOINT5_DISPATCH)
+#pragma GCC pop_options
+#endif
+#endif
+
+    // same estrin pairing as the scalar poly, so the zero-padded tables round identically
+    template <class simd, size_t S, size_t N>
+    typename simd::vdouble poly(typename simd::vdouble x, typename simd::vindex idx, const std::array<std::array<double, S>, N>& coef, size_t n) {
+        typename simd::vdouble s[N];
+
+        for (size_t i = 0; i < n; i++) {
+            s[i] = simd::gather(coef[i].data(), idx);
+        }
+
+        for (; n > 1; n = (n + 1) / 2) {
+            for (size_t i = 0; i < n / 2; i++) {
+                s[i] = simd::muladd(s[2 * i + 1], x, s[2 * i]);
+            }
+            if (n % 2 == 1) {
+                s[n / 2] = s[n - 1];
+            }
+
+            x = simd::mul(x, x);
+        }
+
+        return s[0];
+    }
+
+    template <class simd, size_t N>
+    typename simd::vdouble poly(typename simd::vdouble x, const std::array<double, N>& coef) {
+        typename simd::vdouble s[N];
+
+        for (size_t i = 0; i < N; i++) {
+            s[i] = simd::set1(coef[i]);
+        }
+
+        for (size_t n = N; n > 1; n = (n + 1) / 2) {
+            for (size_t i = 0; i < n / 2; i++) {
+                s[i] = simd::muladd(s[2 * i + 1], x, s[2 * i]);
+            }
+            if (n % 2 == 1) {
+                s[n / 2] = s[n - 1];
+            }
+
+            x = simd::mul(x, x);
+        }
+
+        return s[0];
+    }
+
+    // lane-wise scalar log2_shift
+    template <class simd>
+    typename simd::vdouble log2_shift(typename simd::vdouble x, typename simd::vdouble shift) {
+        using vdouble = typename simd::vdouble;
+        using namespace saspoint5_log2;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0), two = simd::set1(2.0), half = simd::set1(0.5);
+
+        vdouble carry = simd::band(simd::iadd(simd::band(x, simd::bits(0x000FFFFF00000000ull)), simd::bits(0x00095F6400000000ull)), simd::bits(0x0010000000000000ull));
+
+        vdouble f = simd::sub(simd::bor(simd::band(x, simd::bits(0x000FFFFFFFFFFFFFull)), simd::bxor(carry, simd::bits(0x3FF0000000000000ull))), one);
+        vdouble e = simd::add(simd::add(simd::exponent(x), simd::select(simd::gt(carry, zero), one, zero)), shift);
+
+        vdouble s = simd::div(f, simd::add(two, f)), z = simd::mul(s, s), hfsq = simd::mul(simd::mul(half, f), f);
+        vdouble r = simd::mul(s, simd::muladd(z, poly<simd>(z, lg), hfsq));
+
+        vdouble hi = simd::band(simd::sub(f, hfsq), simd::bits(0xFFFFFFFF00000000ull));
+        vdouble lo = simd::add(simd::sub(simd::sub(f, hi), hfsq), r);
+
+        vdouble val_hi = simd::mul(hi, simd::set1(ivln2_hi));
+        vdouble val_lo = simd::muladd(simd::add(lo, hi), simd::set1(ivln2_lo), simd::mul(lo, simd::set1(ivln2_hi)));
+        vdouble w = simd::add(e, val_hi);
+
+        val_lo = simd::add(val_lo, simd::add(simd::sub(e, w), val_hi));
+
+        return simd::add(val_lo, w);
+    }
+
+    template <class simd, size_t S, size_t N, size_t M>
+    typename simd::vdouble pade(typename simd::vdouble x, typename simd::vindex idx, typename simd::vmask head, const pade_table<S, N, M>& table) {
+        bool full = simd::any(head);
+
+        typename simd::vdouble sc = poly<simd>(x, idx, table.numer, full ? N : table.numer_tail);
+        typename simd::vdouble sd = poly<simd>(x, idx, table.denom, full ? M : table.denom_tail);
+
+        return simd::div(sc, sd);
+    }
+
+    template <class simd>
+    void pdf_kernel(const double* xs, double* ys, size_t n) {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::abs(simd::load(xs + i));
+
+            vdouble c = zero;
+            for (double bound : pdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1(pdf::bounds.back()));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(pdf::table.offset.data(), idx)));
+            vdouble y = pade<simd>(t, idx, simd::eq(c, zero), pdf::table);
+
+            y = simd::mul(y, simd::select(limit, simd::mul(simd::mul(u, u), u), one));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_pdf(xs[i]);
+        }
+    }
+
+    template <class simd>
+    void logpdf_kernel(const double* xs, double* ys, size_t n) {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0), inf = simd::set1(std::numeric_limits<double>::infinity());
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::abs(simd::load(xs + i));
+
+            vdouble c = zero;
+            for (double bound : pdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1(pdf::bounds.back()));
+            typename simd::vmask huge = simd::gt(x, simd::set1(0x1p600));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(pdf::table.offset.data(), idx)));
+            vdouble y = pade<simd>(t, idx, simd::eq(c, zero), pdf::table);
+
+            y = simd::mul(y, simd::select(limit, simd::select(huge, one, simd::mul(simd::mul(u, u), u)), one));
+            y = log2_shift<simd>(y, zero);
+
+            if (simd::any(huge)) {
+                y = simd::select(huge, simd::muladd(simd::set1(-1.5), log2_shift<simd>(x, zero), y), y);
+            }
+
+            y = simd::mul(y, simd::set1(std::numbers::ln2));
+            y = simd::select(simd::eq(x, inf), simd::neg(inf), y);
+            y = simd::select(simd::eq(x, x), y, x);
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_logpdf(xs[i]);
+        }
+    }
+
+    template <class simd, size_t S, size_t N, size_t M, size_t DN, size_t DM>
+    typename simd::vdouble pade_derivative(
+        typename simd::vdouble x, typename simd::vindex idx, typename simd::vmask head,
+        const pade_table<S, N, M>& table, const pade_table<S, DN, DM>& dtable, typename simd::vdouble& value) {
+
+        bool full = simd::any(head);
+
+        typename simd::vdouble sc = poly<simd>(x, idx, table.numer, full ? N : table.numer_tail);
+        typename simd::vdouble sd = poly<simd>(x, idx, table.denom, full ? M : table.denom_tail);
+        typename simd::vdouble dc = poly<simd>(x, idx, dtable.numer, full ? DN : dtable.numer_tail);
+        typename simd::vdouble dd = poly<simd>(x, idx, dtable.denom, full ? DM : dtable.denom_tail);
+
+        value = simd::div(sc, sd);
+
+        return simd::div(simd::muladd(dc, sd, simd::neg(simd::mul(sc, dd))), simd::mul(sd, sd));
+    }
+
+    // score = false: d/dx pdf, score = true: d/dx log(pdf)
+    template <class simd, bool score>
+    void pdf_derivative_kernel(const double* xs, double* ys, size_t n) {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0), three = simd::set1(3.0), half = simd::set1(-0.5);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::load(xs + i);
+            vdouble sign = simd::select(simd::gt(x, zero), one, simd::select(simd::gt(zero, x), simd::neg(one), zero));
+
+            x = simd::abs(x);
+
+            vdouble c = zero;
+            for (double bound : pdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1(pdf::bounds.back()));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(pdf::table.offset.data(), idx)));
+
+            vdouble p;
+            vdouble dp = pade_derivative<simd>(t, idx, simd::eq(c, zero), pdf::table, pdf::dtable, p);
+
+            vdouble y;
+            if constexpr (score) {
+                vdouble r = simd::div(dp, p);
+
+                y = simd::select(limit, simd::mul(simd::mul(half, simd::mul(u, u)), simd::muladd(r, u, three)), r);
+            }
+            else {
+                vdouble u2 = simd::mul(u, u);
+
+                y = simd::select(limit, simd::mul(simd::mul(half, simd::mul(simd::mul(u2, u2), u)), simd::muladd(dp, u, simd::mul(three, p))), dp);
+            }
+
+            y = simd::mul(y, sign);
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = score ? saspoint5_score(xs[i]) : saspoint5_pdf_derivative(xs[i]);
+        }
+    }
+
+    template <class simd>
+    void cdf_kernel(const double* xs, double* ys, size_t n, bool complementary) {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::load(xs + i);
+
+            typename simd::vmask inversion = simd::le(x, zero);
+            if (complementary) {
+                inversion = simd::bnot(inversion);
+            }
+
+            x = simd::abs(x);
+
+            vdouble c = zero;
+            for (double bound : cdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1(cdf::bounds.back()));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(cdf::table.offset.data(), idx)));
+            vdouble y = pade<simd>(t, idx, simd::eq(c, zero), cdf::table);
+
+            y = simd::mul(y, simd::select(limit, u, one));
+            y = simd::select(inversion, y, simd::sub(one, y));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_cdf(xs[i], complementary);
+        }
+    }
+
+    template <class simd>
+    void pdf_cdf_kernel(const double* xs, double* pdfs, double* cdfs, double* ccdfs, size_t n) {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0), two = simd::set1(2.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::load(xs + i);
+
+            typename simd::vmask negative = simd::le(x, zero);
+
+            x = simd::abs(x);
+
+            vdouble c = zero;
+            for (double bound : pdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            vdouble c_cdf = simd::select(simd::gt(c, two), simd::sub(c, two), zero);
+
+            typename simd::vindex idx = simd::index(c), idx_cdf = simd::index(c_cdf);
+            typename simd::vmask limit = simd::gt(x, simd::set1(pdf::bounds.back()));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(pdf::table.offset.data(), idx)));
+            vdouble t_cdf = simd::select(limit, u, simd::sub(x, simd::gather(cdf::table.offset.data(), idx_cdf)));
+
+            vdouble pdf = pade<simd>(t, idx, simd::eq(c, zero), pdf::table);
+            vdouble y = pade<simd>(t_cdf, idx_cdf, simd::eq(c_cdf, zero), cdf::table);
+
+            pdf = simd::mul(pdf, simd::select(limit, simd::mul(simd::mul(u, u), u), one));
+            y = simd::mul(y, simd::select(limit, u, one));
+
+            vdouble cy = simd::sub(one, y);
+
+            simd::store(pdfs + i, pdf);
+            simd::store(cdfs + i, simd::select(negative, y, cy));
+            simd::store(ccdfs + i, simd::select(negative, cy, y));
+        }
+
+        for (; i < n; i++) {
+            saspoint5_pdf_cdf_value value = saspoint5_pdf_cdf(xs[i]);
+
+            pdfs[i] = value.pdf;
+            cdfs[i] = value.cdf;
+            ccdfs[i] = value.ccdf;
+        }
+    }
+
+    template <class simd>
+    void quantile_kernel(const double* xs, double* ys, size_t n, bool complementary) {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::load(xs + i);
+
+            typename simd::vmask flip = simd::gt(x, simd::set1(0.5));
+            x = simd::select(flip, simd::sub(one, x), x);
+
+            vdouble exponent = simd::exponent(x);
+
+            vdouble c = zero;
+            for (double e : quantile::exponents) {
+                c = simd::count(c, simd::ge(exponent, simd::set1(e)));
+            }
+
+            vdouble u = simd::neg(log2_shift<simd>(x, simd::gather(quantile::shifts.data(), simd::index(c))));
+
+            typename simd::vmask head = simd::eq(c, simd::set1((double)quantile::exponents.size()));
+
+            vdouble s = zero;
+            for (double bound : quantile::bounds) {
+                s = simd::count(s, simd::gt(u, simd::set1(bound)));
+            }
+            s = simd::select(head, s, simd::sub(simd::set1((double)(quantile::exponents.size() + quantile::bounds.size())), c));
+
+            typename simd::vindex idx = simd::index(simd::select(simd::eq(c, zero), zero, s));
+
+            vdouble t = simd::sub(u, simd::gather(quantile::table.offset.data(), idx));
+            vdouble v = pade<simd>(t, idx, simd::eq(s, zero), quantile::table);
+
+            v = simd::select(simd::eq(c, zero), simd::set1(std::ldexp(1 / std::numbers::pi, -1)), v);
+
+            vdouble y = simd::div(v, simd::mul(x, x));
+
+            y = complementary ? y : simd::neg(y);
+            y = simd::select(flip, simd::neg(y), y);
+            y = simd::select(simd::ge(x, zero), y, simd::set1(std::numeric_limits<double>::quiet_NaN()));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_quantile(xs[i], complementary);
+        }
+    }
+    // neumaier compensated summation
+    struct compensated_sum {
+        double sum = 0, comp = 0;
+
+        void add(double v) {
+            double t = sum + v;
+
+            comp += (std::abs(sum) >= std::abs(v)) ? ((sum - t) + v) : ((v - t) + sum);
+            sum = t;
+        }
+
+        void add(const compensated_sum& other) {
+            add(other.sum);
+            add(other.comp);
+        }
+
+        double value() const {
+            return sum + comp;
+        }
+    };
+
+    template <class simd>
+    compensated_sum loglikelihood_kernel(const double* xs, size_t n, double mu, double c_inv) {
+        using vdouble = typename simd::vdouble;
+
+        constexpr size_t chunk_size = 512;
+
+        alignas(64) double buffer[chunk_size];
+
+        vdouble sum = simd::set1(0.0), comp = simd::set1(0.0);
+        compensated_sum total;
+
+        for (size_t i = 0; i < n; i += chunk_size) {
+            size_t m = std::min(chunk_size, n - i);
+
+            for (size_t j = 0; j < m; j++) {
+                buffer[j] = (xs[i + j] - mu) * c_inv;
+            }
+
+            // the tail through one padded vector, as the dispatched saspoint5_logpdf evaluates it
+            size_t padded = std::min(chunk_size, (m + simd::lanes - 1) / simd::lanes * simd::lanes);
+            std::fill(buffer + m, buffer + padded, 0.0);
+
+            logpdf_kernel<simd>(buffer, buffer, padded);
+
+            size_t j = 0;
+            for (; j + simd::lanes <= m; j += simd::lanes) {
+                vdouble v = simd::load(buffer + j);
+                vdouble t = simd::add(sum, v);
+
+                vdouble d = simd::select(
+                    simd::ge(simd::abs(sum), simd::abs(v)),
+                    simd::add(simd::sub(sum, t), v),
+                    simd::add(simd::sub(v, t), sum)
+                );
+
+                comp = simd::add(comp, d);
+                sum = t;
+            }
+
+            for (; j < m; j++) {
+                total.add(buffer[j]);
+            }
+        }
+
+        alignas(64) double sums[simd::lanes], comps[simd::lanes];
+
+        simd::store(sums, sum);
+        simd::store(comps, comp);
+
+        for (size_t k = 0; k < simd::lanes; k++) {
+            total.add(compensated_sum{ sums[k], comps[k] });
+        }
+
+        return total;
+    }
+}
+
+#if defined(SASPOINT5_DISPATCH)
+enum class saspoint5_isa {
+    scalar, avx2, avx512
+};
+
+namespace saspoint5_dispatch {
+    struct kernel_table {
+        void (*pdf)(const double* xs, double* ys, size_t n);
+        void (*cdf)(const double* xs, double* ys, size_t n, bool complementary);
+        void (*quantile)(const double* xs, double* ys, size_t n, bool complementary);
+        void (*pdf_cdf)(const double* xs, double* pdfs, double* cdfs, double* ccdfs, size_t n);
+        void (*logpdf)(const double* xs, double* ys, size_t n);
+        void (*pdf_derivative)(const double* xs, double* ys, size_t n);
+        void (*score)(const double* xs, double* ys, size_t n);
+        saspoint5_simd::compensated_sum (*loglikelihood)(const double* xs, size_t n, double mu, double c_inv);
+    };
+
+    // runs the kernel on whole vectors only, the tail through a padded copy
+    template <class simd, class Kernel>
+    inline void padded(Kernel kernel, const double* xs, double* ys, size_t n) {
+        size_t m = n - n % simd::lanes;
+
+        kernel(xs, ys, m);
+
+        if (m < n) {
+            double x[simd::lanes], y[simd::lanes];
+
+            for (size_t i = 0; i < simd::lanes; i++) {
+                x[i] = xs[std::min(m + i, n - 1)];
+            }
+
+            kernel(x, y, simd::lanes);
+
+            std::copy(y, y + (n - m), ys + m);
+        }
+    }
+
+    inline void pdf_scalar(const double* xs, double* ys, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            ys[i] = saspoint5_pdf(xs[i]);
+        }
+    }
+
+    inline void cdf_scalar(const double* xs, double* ys, size_t n, bool complementary) {
+        for (size_t i = 0; i < n; i++) {
+            ys[i] = saspoint5_cdf(xs[i], complementary);
+        }
+    }
+
+    inline void quantile_scalar(const double* xs, double* ys, size_t n, bool complementary) {
+        for (size_t i = 0; i < n; i++) {
+            ys[i] = saspoint5_quantile(xs[i], complementary);
+        }
+    }
+
+    inline void pdf_cdf_scalar(const double* xs, double* pdfs, double* cdfs, double* ccdfs, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            saspoint5_pdf_cdf_value value = saspoint5_pdf_cdf(xs[i]);
+
+            pdfs[i] = value.pdf;
+            cdfs[i] = value.cdf;
+            ccdfs[i] = value.ccdf;
+        }
+    }
+
+    inline void logpdf_scalar(const double* xs, double* ys, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            ys[i] = saspoint5_logpdf(xs[i]);
+        }
+    }
+
+    inline void pdf_derivative_scalar(const double* xs, double* ys, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            ys[i] = saspoint5_pdf_derivative(xs[i]);
+        }
+    }
+
+    inline void score_scalar(const double* xs, double* ys, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            ys[i] = saspoint5_score(xs[i]);
+        }
+    }
+
+    inline saspoint5_simd::compensated_sum loglikelihood_scalar(const double* xs, size_t n, double mu, double c_inv) {
+        saspoint5_simd::compensated_sum total;
+
+        for (size_t i = 0; i < n; i++) {
+            total.add(saspoint5_logpdf((xs[i] - mu) * c_inv));
+        }
+
+        return total;
+    }
+
+    // flatten inlines the target-independent kernel templates, so they are compiled for the target
+    template <class simd>
+    struct kernels {
+        static void pdf(const double* xs, double* ys, size_t n) {
+            padded<simd>([](const double* x, double* y, size_t m) {
+                saspoint5_simd::pdf_kernel<simd>(x, y, m);
+            }, xs, ys, n);
+        }
+
+        static void cdf(const double* xs, double* ys, size_t n, bool complementary) {
+            padded<simd>([complementary](const double* x, double* y, size_t m) {
+                saspoint5_simd::cdf_kernel<simd>(x, y, m, complementary);
+            }, xs, ys, n);
+        }
+
+        static void quantile(const double* xs, double* ys, size_t n, bool complementary) {
+            padded<simd>([complementary](const double* x, double* y, size_t m) {
+                saspoint5_simd::quantile_kernel<simd>(x, y, m, complementary);
+            }, xs, ys, n);
+        }
+
+        static void pdf_cdf(const double* xs, double* pdfs, double* cdfs, double* ccdfs, size_t n) {
+            size_t m = n - n % simd::lanes;
+
+            saspoint5_simd::pdf_cdf_kernel<simd>(xs, pdfs, cdfs, ccdfs, m);
+
+            if (m < n) {
+                double x[simd::lanes], pdf[simd::lanes], cdf[simd::lanes], ccdf[simd::lanes];
+
+                for (size_t i = 0; i < simd::lanes; i++) {
+                    x[i] = xs[std::min(m + i, n - 1)];
+                }
+
+                saspoint5_simd::pdf_cdf_kernel<simd>(x, pdf, cdf, ccdf, simd::lanes);
+
+                std::copy(pdf, pdf + (n - m), pdfs + m);
+                std::copy(cdf, cdf + (n - m), cdfs + m);
+                std::copy(ccdf, ccdf + (n - m), ccdfs + m);
+            }
+        }
+
+        static void logpdf(const double* xs, double* ys, size_t n) {
+            padded<simd>([](const double* x, double* y, size_t m) {
+                saspoint5_simd::logpdf_kernel<simd>(x, y, m);
+            }, xs, ys, n);
+        }
+
+        static void pdf_derivative(const double* xs, double* ys, size_t n) {
+            padded<simd>([](const double* x, double* y, size_t m) {
+                saspoint5_simd::pdf_derivative_kernel<simd, false>(x, y, m);
+            }, xs, ys, n);
+        }
+
+        static void score(const double* xs, double* ys, size_t n) {
+            padded<simd>([](const double* x, double* y, size_t m) {
+                saspoint5_simd::pdf_derivative_kernel<simd, true>(x, y, m);
+            }, xs, ys, n);
+        }
+    };
+
+    __attribute__((target("avx2,fma"), flatten)) inline void pdf_avx2(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx2>::pdf(xs, ys, n);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void cdf_avx2(const double* xs, double* ys, size_t n, bool complementary) {
+        kernels<saspoint5_simd::avx2>::cdf(xs, ys, n, complementary);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void quantile_avx2(const double* xs, double* ys, size_t n, bool complementary) {
+        kernels<saspoint5_simd::avx2>::quantile(xs, ys, n, complementary);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void pdf_cdf_avx2(const double* xs, double* pdfs, double* cdfs, double* ccdfs, size_t n) {
+        kernels<saspoint5_simd::avx2>::pdf_cdf(xs, pdfs, cdfs, ccdfs, n);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void logpdf_avx2(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx2>::logpdf(xs, ys, n);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void pdf_derivative_avx2(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx2>::pdf_derivative(xs, ys, n);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void score_avx2(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx2>::score(xs, ys, n);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline saspoint5_simd::compensated_sum loglikelihood_avx2(const double* xs, size_t n, double mu, double c_inv) {
+        return saspoint5_simd::loglikelihood_kernel<saspoint5_simd::avx2>(xs, n, mu, c_inv);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void pdf_avx512(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx512>::pdf(xs, ys, n);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void cdf_avx512(const double* xs, double* ys, size_t n, bool complementary) {
+        kernels<saspoint5_simd::avx512>::cdf(xs, ys, n, complementary);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void quantile_avx512(const double* xs, double* ys, size_t n, bool complementary) {
+        kernels<saspoint5_simd::avx512>::quantile(xs, ys, n, complementary);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void pdf_cdf_avx512(const double* xs, double* pdfs, double* cdfs, double* ccdfs, size_t n) {
+        kernels<saspoint5_simd::avx512>::pdf_cdf(xs, pdfs, cdfs, ccdfs, n);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void logpdf_avx512(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx512>::logpdf(xs, ys, n);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void pdf_derivative_avx512(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx512>::pdf_derivative(xs, ys, n);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void score_avx512(const double* xs, double* ys, size_t n) {
+        kernels<saspoint5_simd::avx512>::score(xs, ys, n);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline saspoint5_simd::compensated_sum loglikelihood_avx512(const double* xs, size_t n, double mu, double c_inv) {
+        return saspoint5_simd::loglikelihood_kernel<saspoint5_simd::avx512>(xs, n, mu, c_inv);
+    }
+
+    // indexed by saspoint5_isa
+    inline constexpr std::array<kernel_table, 3> tables = {{
+        { pdf_scalar, cdf_scalar, quantile_scalar, pdf_cdf_scalar, logpdf_scalar, pdf_derivative_scalar, score_scalar, loglikelihood_scalar },
+        { pdf_avx2, cdf_avx2, quantile_avx2, pdf_cdf_avx2, logpdf_avx2, pdf_derivative_avx2, score_avx2, loglikelihood_avx2 },
+        { pdf_avx512, cdf_avx512, quantile_avx512, pdf_cdf_avx512, logpdf_avx512, pdf_derivative_avx512, score_avx512, loglikelihood_avx512 },
+    }};
+
+    inline bool supported(saspoint5_isa isa) {
+        __builtin_cpu_init();
+
+        switch (isa) {
+        case saspoint5_isa::avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case saspoint5_isa::avx512:
+            return __builtin_cpu_supports("avx512f");
+        default:
+            return true;
+        }
+    }
+
+    inline saspoint5_isa best() {
+        return supported(saspoint5_isa::avx512) ? saspoint5_isa::avx512 :
+               supported(saspoint5_isa::avx2) ? saspoint5_isa::avx2 : saspoint5_isa::scalar;
+    }
+
+    // SASPOINT5_ISA when it names a supported path, otherwise the best one
+    inline saspoint5_isa initial() {
+        constexpr std::string_view names[] = { "scalar", "avx2", "avx512" };
+
+        const char* env = getenv("SASPOINT5_ISA");
+        std::string_view name = (env != nullptr) ? env : "";
+
+        for (saspoint5_isa isa : { saspoint5_isa::scalar, saspoint5_isa::avx2, saspoint5_isa::avx512 }) {
+            if (name == names[(size_t)isa] && supported(isa)) {
+                return isa;
+            }
+        }
+
+        return best();
+    }
+
+    inline std::atomic<saspoint5_isa>& current() {
+        static std::atomic<saspoint5_isa> isa(initial());
+        return isa;
+    }
+
+    inline const kernel_table& table() {
+        return tables[(size_t)current().load(std::memory_order_relaxed)];
+    }
+}
+
+inline bool saspoint5_isa_supported(saspoint5_isa isa) {
+    return saspoint5_dispatch::supported(isa);
+}
+
+inline saspoint5_isa saspoint5_get_isa() {
+    return saspoint5_dispatch::current().load(std::memory_order_relaxed);
+}
+
+// false, and the path is left unchanged, when the cpu does not support isa
+inline bool saspoint5_set_isa(saspoint5_isa isa) {
+    if (!saspoint5_dispatch::supported(isa)) {
+        return false;
+    }
+
+    saspoint5_dispatch::current().store(isa, std::memory_order_relaxed);
+
+    return true;
+}
+#endif
+
+namespace saspoint5_simd {
+    inline compensated_sum loglikelihood_range(const double* xs, size_t n, double mu, double c_inv) {
+#if defined(SASPOINT5_DISPATCH)
+        return saspoint5_dispatch::table().loglikelihood(xs, n, mu, c_inv);
+#elif defined(__AVX512F__)
+        return loglikelihood_kernel<avx512>(xs, n, mu, c_inv);
+#elif defined(__AVX2__)
+        return loglikelihood_kernel<avx2>(xs, n, mu, c_inv);
+#else
+        compensated_sum total;
+
+        for (size_t i = 0; i < n; i++) {
+            total.add(saspoint5_logpdf((xs[i] - mu) * c_inv));
+        }
+
+        return total;
+#endif
+    }
+
+    // splits [0, n) into one contiguous block per pool thread, at least min_block long,
+    // evaluates func(begin, end) -> R on each block and merges the results in block order by R::add;
+    // an exception from any block is rethrown once all blocks have stopped
+    template <class R, class F>
+    R parallel_reduce(size_t n, size_t min_block, F func) {
+        if (n / min_block <= 1) {
+            return func(0, n);
+        }
+
+        saspoint5_parallel::thread_pool& pool = saspoint5_parallel::thread_pool::instance();
+
+        size_t threads = std::min(n / min_block, pool.size());
+        size_t block = (n + threads - 1) / threads;
+
+        std::vector<R> partial(threads);
+
+        pool.run(threads, [&](size_t t) {
+            partial[t] = func(std::min(n, t * block), std::min(n, (t + 1) * block));
+        });
+
+        R total = partial[0];
+        for (size_t t = 1; t < threads; t++) {
+            total.add(partial[t]);
+        }
+
+        return total;
+    }
+
+    // sum of logpdf((x - mu) / c) - n log(c), threaded for n >= 2^16 per thread
+    inline double loglikelihood(std::span<const double> x, double mu, double c_inv, double log_c) {
+        compensated_sum total = parallel_reduce<compensated_sum>(x.size(), 1 << 16, [&](size_t begin, size_t end) {
+            return loglikelihood_range(x.data() + begin, end - begin, mu, c_inv);
+        });
+
+        total.add(-(double)x.size() * log_c);
+
+        return total.value();
+    }
+}
+
+inline void saspoint5_pdf(std::span<const double> x, std::span<double> y) {
+    assert(x.size() == y.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().pdf(x.data(), y.data(), x.size());
+#elif defined(__AVX512F__)
+    saspoint5_simd::pdf_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size());
+#elif defined(__AVX2__)
+    saspoint5_simd::pdf_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size());
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_pdf(x[i]);
+    }
+#endif
+}
+
+inline void saspoint5_cdf(std::span<const double> x, std::span<double> y, bool complementary = false) {
+    assert(x.size() == y.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().cdf(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX512F__)
+    saspoint5_simd::cdf_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX2__)
+    saspoint5_simd::cdf_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size(), complementary);
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_cdf(x[i], complementary);
+    }
+#endif
+}
+
+inline void saspoint5_quantile(std::span<const double> x, std::span<double> y, bool complementary = false) {
+    assert(x.size() == y.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().quantile(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX512F__)
+    saspoint5_simd::quantile_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX2__)
+    saspoint5_simd::quantile_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size(), complementary);
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_quantile(x[i], complementary);
+    }
+#endif
+}
+
+inline void saspoint5_pdf_cdf(std::span<const double> x, std::span<double> pdf, std::span<double> cdf, std::span<double> ccdf) {
+    assert(x.size() == pdf.size() && x.size() == cdf.size() && x.size() == ccdf.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().pdf_cdf(x.data(), pdf.data(), cdf.data(), ccdf.data(), x.size());
+#elif defined(__AVX512F__)
+    saspoint5_simd::pdf_cdf_kernel<saspoint5_simd::avx512>(x.data(), pdf.data(), cdf.data(), ccdf.data(), x.size());
+#elif defined(__AVX2__)
+    saspoint5_simd::pdf_cdf_kernel<saspoint5_simd::avx2>(x.data(), pdf.data(), cdf.data(), ccdf.data(), x.size());
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        saspoint5_pdf_cdf_value value = saspoint5_pdf_cdf(x[i]);
+
+        pdf[i] = value.pdf;
+        cdf[i] = value.cdf;
+        ccdf[i] = value.ccdf;
+    }
+#endif
+}
+
+inline void saspoint5_logpdf(std::span<const double> x, std::span<double> y) {
+    assert(x.size() == y.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().logpdf(x.data(), y.data(), x.size());
+#elif defined(__AVX512F__)
+    saspoint5_simd::logpdf_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size());
+#elif defined(__AVX2__)
+    saspoint5_simd::logpdf_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size());
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_logpdf(x[i]);
+    }
+#endif
+}
+
+inline double saspoint5_loglikelihood(std::span<const double> x, double mu = 0, double c = 1) {
+    assert(c > 0);
+
+    return saspoint5_simd::loglikelihood(x, mu, 1 / c, std::log(c));
+}
+
+inline void saspoint5_pdf_derivative(std::span<const double> x, std::span<double> y) {
+    assert(x.size() == y.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().pdf_derivative(x.data(), y.data(), x.size());
+#elif defined(__AVX512F__)
+    saspoint5_simd::pdf_derivative_kernel<saspoint5_simd::avx512, false>(x.data(), y.data(), x.size());
+#elif defined(__AVX2__)
+    saspoint5_simd::pdf_derivative_kernel<saspoint5_simd::avx2, false>(x.data(), y.data(), x.size());
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_pdf_derivative(x[i]);
+    }
+#endif
+}
+
+inline void saspoint5_score(std::span<const double> x, std::span<double> y) {
+    assert(x.size() == y.size());
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::table().score(x.data(), y.data(), x.size());
+#elif defined(__AVX512F__)
+    saspoint5_simd::pdf_derivative_kernel<saspoint5_simd::avx512, true>(x.data(), y.data(), x.size());
+#elif defined(__AVX2__)
+    saspoint5_simd::pdf_derivative_kernel<saspoint5_simd::avx2, true>(x.data(), y.data(), x.size());
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_score(x[i]);
+    }
+#endif
+}
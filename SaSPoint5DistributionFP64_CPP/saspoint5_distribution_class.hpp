@@ -0,0 +1,187 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// SaS(alpha=1/2) distribution with location mu and scale c, port of the C# SaSPoint5Distribution.
+// 1/c and log(c) are computed once at construction; the span overloads standardize
+// and rescale around the batch kernels in cache-sized chunks.
+
+#pragma once
+
+#include <stdexcept>
+
+#include "saspoint5_distribution_sorted.hpp"
+
+class saspoint5_distribution {
+public:
+    static constexpr double entropy_base = 3.63992444568030649573;
+
+    explicit saspoint5_distribution(double mu = 0, double c = 1) : mu_(mu), c_(c) {
+        if (!std::isfinite(mu)) {
+            throw std::out_of_range("Invalid location parameter.");
+        }
+        if (!(c > 0 && std::isfinite(c))) {
+            throw std::out_of_range("Invalid scale parameter.");
+        }
+
+        c_inv_ = 1 / c;
+        log_c_ = std::log(c);
+    }
+
+    double mu() const {
+        return mu_;
+    }
+
+    double c() const {
+        return c_;
+    }
+
+    double pdf(double x) const {
+        double u = (x - mu_) * c_inv_;
+
+        if (std::isnan(u)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        return saspoint5_pdf(u) * c_inv_;
+    }
+
+    double cdf(double x, bool complementary = false) const {
+        double u = (x - mu_) * c_inv_;
+
+        if (std::isnan(u)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        return saspoint5_cdf(u, complementary);
+    }
+
+    double logpdf(double x) const {
+        double u = (x - mu_) * c_inv_;
+
+        return saspoint5_logpdf(u) - log_c_;
+    }
+
+    double logcdf(double x, bool complementary = false) const {
+        double u = (x - mu_) * c_inv_;
+
+        return saspoint5_logcdf(u, complementary);
+    }
+
+    double pdf_derivative(double x) const {
+        double u = (x - mu_) * c_inv_;
+
+        return saspoint5_pdf_derivative(u) * (c_inv_ * c_inv_);
+    }
+
+    double score(double x) const {
+        double u = (x - mu_) * c_inv_;
+
+        return saspoint5_score(u) * c_inv_;
+    }
+
+    double quantile(double p, bool complementary = false) const {
+        return saspoint5_detail::fmadd(saspoint5_quantile(p, complementary), c_, mu_);
+    }
+
+    void pdf(std::span<const double> x, std::span<double> y) const {
+        assert(x.size() == y.size());
+
+        for (size_t i = 0; i < x.size(); i += chunk_size) {
+            std::span<double> v = y.subspan(i, std::min(chunk_size, x.size() - i));
+
+            standardize(x.subspan(i, v.size()), v);
+            saspoint5_pdf(v, v);
+
+            for (double& w : v) {
+                w *= c_inv_;
+            }
+        }
+    }
+
+    void cdf(std::span<const double> x, std::span<double> y, bool complementary = false) const {
+        assert(x.size() == y.size());
+
+        for (size_t i = 0; i < x.size(); i += chunk_size) {
+            std::span<double> v = y.subspan(i, std::min(chunk_size, x.size() - i));
+
+            standardize(x.subspan(i, v.size()), v);
+            saspoint5_cdf(v, v, complementary);
+        }
+    }
+
+    void quantile(std::span<const double> p, std::span<double> y, bool complementary = false) const {
+        assert(p.size() == y.size());
+
+        saspoint5_quantile(p, y, complementary);
+
+        for (double& v : y) {
+            v = saspoint5_detail::fmadd(v, c_, mu_);
+        }
+    }
+
+    // bin masses of the ascending edges, see saspoint5_interval_probability
+    void interval_probability(std::span<const double> edges, std::span<double> probability) const {
+        assert(edges.size() == probability.size() + 1 || (edges.empty() && probability.empty()));
+        assert(std::is_sorted(edges.begin(), edges.end()));
+
+        saspoint5_sorted::interval_probability(edges, probability, mu_, c_inv_);
+    }
+
+    double loglikelihood(std::span<const double> x) const {
+        return saspoint5_simd::loglikelihood(x, mu_, c_inv_, log_c_);
+    }
+
+    double median() const {
+        return mu_;
+    }
+
+    double mode() const {
+        return mu_;
+    }
+
+    double entropy() const {
+        return entropy_base + log_c_;
+    }
+
+    // stable closure: X1 + X2 ~ SaS(mu1 + mu2, (sqrt(c1) + sqrt(c2))^2)
+    friend saspoint5_distribution operator+(const saspoint5_distribution& dist1, const saspoint5_distribution& dist2) {
+        double s = std::sqrt(dist1.c_) + std::sqrt(dist2.c_);
+
+        return saspoint5_distribution(dist1.mu_ + dist2.mu_, s * s);
+    }
+
+    friend saspoint5_distribution operator-(const saspoint5_distribution& dist1, const saspoint5_distribution& dist2) {
+        double s = std::sqrt(dist1.c_) + std::sqrt(dist2.c_);
+
+        return saspoint5_distribution(dist1.mu_ - dist2.mu_, s * s);
+    }
+
+    friend saspoint5_distribution operator+(const saspoint5_distribution& dist, double s) {
+        return saspoint5_distribution(dist.mu_ + s, dist.c_);
+    }
+
+    friend saspoint5_distribution operator-(const saspoint5_distribution& dist, double s) {
+        return saspoint5_distribution(dist.mu_ - s, dist.c_);
+    }
+
+    friend saspoint5_distribution operator*(const saspoint5_distribution& dist, double k) {
+        return saspoint5_distribution(dist.mu_ * k, dist.c_ * k);
+    }
+
+    friend saspoint5_distribution operator/(const saspoint5_distribution& dist, double k) {
+        return saspoint5_distribution(dist.mu_ / k, dist.c_ / k);
+    }
+
+private:
+    static constexpr size_t chunk_size = 512;
+
+    double mu_, c_, c_inv_, log_c_;
+
+    void standardize(std::span<const double> x, std::span<double> u) const {
+        for (size_t i = 0; i < x.size(); i++) {
+            u[i] = (x[i] - mu_) * c_inv_;
+        }
+    }
+};
@@ -0,0 +1,465 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Reduced-accuracy fast mode. saspoint5_fast(tolerance) tabulates every pade segment of
+// saspoint5_pdf/cdf/quantile as piecewise cubics, interpolating at the chebyshev nodes of
+// equal subintervals; the number of subintervals per segment is doubled until the relative
+// error on a fine check grid is below tolerance / 2. Evaluation keeps the segment dispatch and
+// the limit transforms of the full-accuracy functions and replaces each pade by one cubic.
+// The quantile segment starting at the median is tabulated as v(u) / u, which stays nonzero.
+// The span overloads gather the cubics in the avx2/avx512 kernels and match the scalar results bit for bit.
+
+#pragma once
+
+#include <vector>
+
+#include "saspoint5_distribution_batch.hpp"
+
+namespace saspoint5_interp {
+    using namespace saspoint5_detail;
+
+    class cubic_table {
+    public:
+        cubic_table() = default;
+
+        // domain[s] = [lo, hi] of the argument of segments[s].value; divide: tabulate value(t) / t
+        template <size_t S>
+        cubic_table(const std::array<pade_segment, S>& segments, const std::array<std::array<double, 2>, S>& domain, double tolerance, const std::array<bool, S>& divide = {}) {
+            for (size_t s = 0; s < S; s++) {
+                auto f = [&](double t) {
+                    if (!divide[s]) {
+                        return segments[s].value(t);
+                    }
+
+                    return (t != 0) ? segments[s].value(t) / t : segments[s].derivative(0).derivative;
+                };
+
+                build(f, domain[s][0], domain[s][1], tolerance);
+            }
+        }
+
+        double value(size_t s, double t) const {
+            double w = (t - lo[s]) * scale[s];
+            double k = std::min(std::floor(std::max(0.0, w)), last[s]);
+
+            w -= k;
+
+            const double* c = coef.data() + 4 * (size_t)(base[s] + k);
+
+            return fmadd(fmadd(fmadd(c[3], w, c[2]), w, c[1]), w, c[0]);
+        }
+
+#if defined(__AVX2__)
+        template <class simd>
+        typename simd::vdouble value(typename simd::vindex s, typename simd::vdouble t) const {
+            using vdouble = typename simd::vdouble;
+
+            const vdouble zero = simd::set1(0.0);
+
+            vdouble w = simd::mul(simd::sub(t, simd::gather(lo.data(), s)), simd::gather(scale.data(), s));
+            vdouble k = simd::floor(simd::select(simd::gt(w, zero), w, zero));
+            vdouble k_max = simd::gather(last.data(), s);
+
+            k = simd::select(simd::gt(k, k_max), k_max, k);
+            w = simd::sub(w, k);
+
+            typename simd::vindex idx = simd::index(simd::mul(simd::add(simd::gather(base.data(), s), k), simd::set1(4.0)));
+
+            vdouble c0 = simd::gather(coef.data(), idx), c1 = simd::gather(coef.data() + 1, idx);
+            vdouble c2 = simd::gather(coef.data() + 2, idx), c3 = simd::gather(coef.data() + 3, idx);
+
+            return simd::muladd(simd::muladd(simd::muladd(c3, w, c2), w, c1), w, c0);
+        }
+#endif
+
+        // number of cubics
+        size_t size() const {
+            return coef.size() / 4;
+        }
+
+        // appends f on [a, b] as the next segment, false where the tolerance is not met
+        template <class F>
+        bool append(F f, double a, double b, double tolerance, size_t max_count) {
+            return build(f, a, b, tolerance, max_count);
+        }
+
+    private:
+        // per segment: argument offset, subintervals per unit, index of the last subinterval and of the first cubic
+        std::vector<double> lo, scale, last, base;
+
+        // 4 monomial coefficients per cubic
+        std::vector<double> coef;
+
+        // cubic in w through f(a + h w) at the chebyshev nodes of [0, 1], in monomial form
+        template <class F>
+        static std::array<double, 4> fit(F f, double a, double h) {
+            std::array<double, 4> w, d;
+
+            for (size_t j = 0; j < 4; j++) {
+                w[j] = (1 - std::cos((double)(2 * j + 1) * std::numbers::pi / 8)) / 2;
+                d[j] = f(a + h * w[j]);
+            }
+
+            // newton divided differences
+            for (size_t k = 1; k < 4; k++) {
+                for (size_t j = 3; j >= k; j--) {
+                    d[j] = (d[j] - d[j - 1]) / (w[j] - w[j - k]);
+                }
+            }
+
+            std::array<double, 4> c = { d[3], 0, 0, 0 };
+            for (size_t k = 3; k-- > 0;) {
+                for (size_t j = 3; j > 0; j--) {
+                    c[j] = c[j - 1] - w[k] * c[j];
+                }
+                c[0] = d[k] - w[k] * c[0];
+            }
+
+            return c;
+        }
+
+        // false when max_count subintervals still miss the tolerance
+        template <class F>
+        bool build(F f, double a, double b, double tolerance, size_t max_count = 1 << 16) {
+            constexpr size_t checks = 16;
+
+            size_t first = coef.size();
+
+            for (size_t count = 1; ; count *= 2) {
+                double h = (b - a) / (double)count;
+
+                std::vector<std::array<double, 4>> cubics(count);
+                for (size_t i = 0; i < count; i++) {
+                    cubics[i] = fit(f, a + h * (double)i, h);
+                }
+
+                double error = 0;
+                for (size_t i = 0; i < count && error <= tolerance / 2; i++) {
+                    const std::array<double, 4>& c = cubics[i];
+
+                    for (size_t j = 0; j <= checks; j++) {
+                        double w = (double)j / checks;
+                        double expected = f(a + h * ((double)i + w));
+                        double actual = fmadd(fmadd(fmadd(c[3], w, c[2]), w, c[1]), w, c[0]);
+
+                        error = std::max(error, std::abs(actual - expected) / std::abs(expected));
+                    }
+                }
+
+                if (error <= tolerance / 2 || count >= max_count) {
+                    lo.push_back(a);
+                    scale.push_back((double)count / (b - a));
+                    last.push_back((double)(count - 1));
+                    base.push_back((double)(first / 4));
+
+                    for (const std::array<double, 4>& c : cubics) {
+                        coef.insert(coef.end(), c.begin(), c.end());
+                    }
+
+                    return error <= tolerance / 2;
+                }
+            }
+        }
+    };
+}
+
+class saspoint5_fast {
+public:
+    explicit saspoint5_fast(double tolerance = 1e-7) : tolerance_(tolerance) {
+        assert(tolerance > 0);
+
+        using saspoint5_interp::cubic_table;
+
+        pdf_table = cubic_table(saspoint5_pdf_pade::pade_segments, std::array<std::array<double, 2>, 11>{{
+            { 0.0, 0.125 }, { 0.0, 0.125 }, { 0.0, 0.25 }, { 0.0, 0.5 }, { 0.0, 1.0 },
+            { 0.0, 2.0 }, { 0.0, 4.0 }, { 0.0, 8.0 }, { 0.0, 16.0 }, { 0.0, 32.0 }, { 0.0, 0.125 }
+        }}, tolerance);
+
+        cdf_table = cubic_table(saspoint5_cdf_pade::pade_segments, std::array<std::array<double, 2>, 9>{{
+            { 0.0, 0.5 }, { 0.0, 0.5 }, { 0.0, 1.0 }, { 0.0, 2.0 }, { 0.0, 4.0 },
+            { 0.0, 8.0 }, { 0.0, 16.0 }, { 0.0, 32.0 }, { 0.0, 0.125 }
+        }}, tolerance);
+
+        quantile_table = cubic_table(saspoint5_quantile_pade::pade_segments, std::array<std::array<double, 2>, 9>{{
+            { 0.0, 0.125 }, { 0.0, 0.125 }, { 0.0, 0.25 }, { 0.0, 0.5 },
+            { 0.0, 2.0 }, { 0.0, 4.0 }, { 0.0, 8.0 }, { 0.0, 16.0 }, { 0.0, 32.0 }
+        }}, tolerance, std::array<bool, 9>{ true });
+    }
+
+    double tolerance() const {
+        return tolerance_;
+    }
+
+    // number of tabulated cubics
+    size_t table_size() const {
+        return pdf_table.size() + cdf_table.size() + quantile_table.size();
+    }
+
+    double pdf(double x) const {
+        using namespace saspoint5_pdf_pade;
+
+        x = std::abs(x);
+
+        if (std::isnan(x)) {
+            return x;
+        }
+
+        size_t index = (size_t)pow2_segment(x, -3, (int)pade_segments.size());
+
+        double y;
+        if (index < pade_segments.size() - 1) {
+            y = pdf_table.value(index, x - pade_segments[index].offset);
+        }
+        else {
+            double v = std::sqrt(x);
+            double u = 1 / v;
+
+            y = pdf_table.value(index, u) * (u * u * u);
+        }
+
+        return y;
+    }
+
+    double cdf(double x, bool complementary = false) const {
+        using namespace saspoint5_cdf_pade;
+
+        if (std::isnan(x)) {
+            return x;
+        }
+
+        bool inversion = (x <= 0) ^ complementary;
+
+        x = std::abs(x);
+
+        size_t index = (size_t)pow2_segment(x, -1, (int)pade_segments.size());
+
+        double y;
+        if (index < pade_segments.size() - 1) {
+            y = cdf_table.value(index, x - pade_segments[index].offset);
+        }
+        else {
+            double v = std::sqrt(x);
+            double u = 1 / v;
+
+            y = cdf_table.value(index, u) * u;
+        }
+
+        y = inversion ? y : 1 - y;
+
+        return y;
+    }
+
+    double quantile(double x, bool complementary = false) const {
+        using namespace saspoint5_quantile_pade;
+
+        bool flip = x > 0.5;
+        x = flip ? 1 - x : x;
+        complementary ^= flip;
+
+        if (!(x >= 0)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        double v;
+        int exponent = (int)(std::bit_cast<uint64_t>(std::abs(x)) >> 52) - 1023;
+
+        if (exponent >= -64) {
+            int m = (exponent >= -2) ? 1 : std::bit_width((unsigned int)(-exponent - 1));
+            double u = -log2_shift(x, 1 << (m - 1));
+
+            size_t index = (m > 1) ? (size_t)(m + 2) : (size_t)pow2_segment(u, -3, 4);
+            double t = u - pade_segments[index].offset;
+
+            v = quantile_table.value(index, t) * ((index == 0) ? t : 1.0);
+        }
+        else {
+            v = std::ldexp(1 / std::numbers::pi, -1);
+        }
+
+        double y = v / (x * x);
+
+        y = complementary ? y : -y;
+
+        return y;
+    }
+
+    void pdf(std::span<const double> x, std::span<double> y) const {
+        assert(x.size() == y.size());
+
+#if defined(__AVX512F__)
+        pdf_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size());
+#elif defined(__AVX2__)
+        pdf_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size());
+#else
+        for (size_t i = 0; i < x.size(); i++) {
+            y[i] = pdf(x[i]);
+        }
+#endif
+    }
+
+    void cdf(std::span<const double> x, std::span<double> y, bool complementary = false) const {
+        assert(x.size() == y.size());
+
+#if defined(__AVX512F__)
+        cdf_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX2__)
+        cdf_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size(), complementary);
+#else
+        for (size_t i = 0; i < x.size(); i++) {
+            y[i] = cdf(x[i], complementary);
+        }
+#endif
+    }
+
+    void quantile(std::span<const double> x, std::span<double> y, bool complementary = false) const {
+        assert(x.size() == y.size());
+
+#if defined(__AVX512F__)
+        quantile_kernel<saspoint5_simd::avx512>(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX2__)
+        quantile_kernel<saspoint5_simd::avx2>(x.data(), y.data(), x.size(), complementary);
+#else
+        for (size_t i = 0; i < x.size(); i++) {
+            y[i] = quantile(x[i], complementary);
+        }
+#endif
+    }
+
+private:
+    double tolerance_;
+    saspoint5_interp::cubic_table pdf_table, cdf_table, quantile_table;
+
+#if defined(__AVX2__)
+    template <class simd>
+    void pdf_kernel(const double* xs, double* ys, size_t n) const {
+        using namespace saspoint5_simd;
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::abs(simd::load(xs + i));
+
+            vdouble c = zero;
+            for (double bound : pdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1(pdf::bounds.back()));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(pdf::table.offset.data(), idx)));
+            vdouble y = pdf_table.value<simd>(idx, t);
+
+            y = simd::mul(y, simd::select(limit, simd::mul(simd::mul(u, u), u), one));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = pdf(xs[i]);
+        }
+    }
+
+    template <class simd>
+    void cdf_kernel(const double* xs, double* ys, size_t n, bool complementary) const {
+        using namespace saspoint5_simd;
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::load(xs + i);
+
+            typename simd::vmask inversion = simd::le(x, zero);
+            if (complementary) {
+                inversion = simd::bnot(inversion);
+            }
+
+            x = simd::abs(x);
+
+            vdouble c = zero;
+            for (double bound : cdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1(bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1(cdf::bounds.back()));
+
+            vdouble v = simd::sqrt(x);
+            vdouble u = simd::div(one, v);
+
+            vdouble t = simd::select(limit, u, simd::sub(x, simd::gather(cdf::table.offset.data(), idx)));
+            vdouble y = cdf_table.value<simd>(idx, t);
+
+            y = simd::mul(y, simd::select(limit, u, one));
+            y = simd::select(inversion, y, simd::sub(one, y));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = cdf(xs[i], complementary);
+        }
+    }
+
+    template <class simd>
+    void quantile_kernel(const double* xs, double* ys, size_t n, bool complementary) const {
+        using namespace saspoint5_simd;
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble x = simd::load(xs + i);
+
+            typename simd::vmask flip = simd::gt(x, simd::set1(0.5));
+            x = simd::select(flip, simd::sub(one, x), x);
+
+            vdouble exponent = simd::exponent(x);
+
+            vdouble c = zero;
+            for (double e : quantile::exponents) {
+                c = simd::count(c, simd::ge(exponent, simd::set1(e)));
+            }
+
+            vdouble u = simd::neg(log2_shift<simd>(x, simd::gather(quantile::shifts.data(), simd::index(c))));
+
+            typename simd::vmask head = simd::eq(c, simd::set1((double)quantile::exponents.size()));
+
+            vdouble s = zero;
+            for (double bound : quantile::bounds) {
+                s = simd::count(s, simd::gt(u, simd::set1(bound)));
+            }
+            s = simd::select(head, s, simd::sub(simd::set1((double)(quantile::exponents.size() + quantile::bounds.size())), c));
+            s = simd::select(simd::eq(c, zero), zero, s);
+
+            vdouble t = simd::sub(u, simd::gather(quantile::table.offset.data(), simd::index(s)));
+            vdouble v = quantile_table.value<simd>(simd::index(s), t);
+
+            v = simd::mul(v, simd::select(simd::eq(s, zero), t, one));
+            v = simd::select(simd::eq(c, zero), simd::set1(std::ldexp(1 / std::numbers::pi, -1)), v);
+
+            vdouble y = simd::div(v, simd::mul(x, x));
+
+            y = complementary ? y : simd::neg(y);
+            y = simd::select(flip, simd::neg(y), y);
+            y = simd::select(simd::ge(x, zero), y, simd::set1(std::numeric_limits<double>::quiet_NaN()));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = quantile(xs[i], complementary);
+        }
+    }
+#endif
+};
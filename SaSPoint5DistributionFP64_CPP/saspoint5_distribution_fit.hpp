@@ -0,0 +1,188 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Maximum likelihood estimation of the SaS(alpha=1/2) location mu and scale c.
+// Starts from the median and quartile range of the data, then runs damped newton iterations
+// in (mu, s = log c). The log-likelihood, gradient and hessian of each iterate come from
+// a single threaded pass over the data; the gradient uses the analytic saspoint5_score and
+// the hessian a central difference of it with the power-of-two step 2^-14 max(|z|, 1).
+
+#pragma once
+
+#include <vector>
+
+#include "saspoint5_distribution_class.hpp"
+
+struct saspoint5_fit_result {
+    double mu, c;
+    double loglikelihood;
+    int iterations;
+    bool converged;
+};
+
+namespace saspoint5_mle {
+    // sums over z = (x - mu) / c of logpdf(z), g = d/dz logpdf(z) and g' = d^2/dz^2 logpdf(z)
+    struct likelihood_sums {
+        saspoint5_simd::compensated_sum l;
+        double g = 0, zg = 0, dg = 0, zdg = 0, zzdg = 0;
+
+        void add(const likelihood_sums& other) {
+            l.add(other.l);
+            g += other.g;
+            zg += other.zg;
+            dg += other.dg;
+            zdg += other.zdg;
+            zzdg += other.zzdg;
+        }
+    };
+
+    inline likelihood_sums likelihood_range(const double* xs, size_t n, double mu, double c_inv) {
+        constexpr size_t chunk_size = 512;
+
+        std::array<double, chunk_size> z, zp, zm, h, l, g, gp, gm;
+
+        likelihood_sums sums;
+
+        for (size_t i = 0; i < n; i += chunk_size) {
+            size_t m = std::min(chunk_size, n - i);
+
+            for (size_t j = 0; j < m; j++) {
+                z[j] = (xs[i + j] - mu) * c_inv;
+                h[j] = std::bit_cast<double>(std::bit_cast<uint64_t>(std::max(std::abs(z[j]), 1.0)) & 0x7FF0000000000000ull) * 0x1p-14;
+                zp[j] = z[j] + h[j];
+                zm[j] = z[j] - h[j];
+            }
+
+            saspoint5_logpdf(std::span<const double>(z.data(), m), std::span<double>(l.data(), m));
+            saspoint5_score(std::span<const double>(z.data(), m), std::span<double>(g.data(), m));
+            saspoint5_score(std::span<const double>(zp.data(), m), std::span<double>(gp.data(), m));
+            saspoint5_score(std::span<const double>(zm.data(), m), std::span<double>(gm.data(), m));
+
+            for (size_t j = 0; j < m; j++) {
+                double dg = (gp[j] - gm[j]) / (2 * h[j]);
+
+                sums.l.add(l[j]);
+                sums.g += g[j];
+                sums.zg += z[j] * g[j];
+                sums.dg += dg;
+                sums.zdg += z[j] * dg;
+                sums.zzdg += z[j] * z[j] * dg;
+            }
+        }
+
+        return sums;
+    }
+
+    // log-likelihood, gradient and hessian with respect to (mu, s = log c)
+    struct likelihood_state {
+        double mu, s;
+        double loglikelihood;
+        double g_mu, g_s;
+        double h_mumu, h_mus, h_ss;
+    };
+
+    inline likelihood_state likelihood(std::span<const double> x, double mu, double s) {
+        double c_inv = std::exp(-s), n = (double)x.size();
+
+        likelihood_sums sums = saspoint5_simd::parallel_reduce<likelihood_sums>(x.size(), 1 << 14, [&](size_t begin, size_t end) {
+            return likelihood_range(x.data() + begin, end - begin, mu, c_inv);
+        });
+
+        sums.l.add(-n * s);
+
+        likelihood_state state;
+        state.mu = mu;
+        state.s = s;
+        state.loglikelihood = sums.l.value();
+        state.g_mu = -sums.g * c_inv;
+        state.g_s = -sums.zg - n;
+        state.h_mumu = sums.dg * c_inv * c_inv;
+        state.h_mus = (sums.zdg + sums.g) * c_inv;
+        state.h_ss = sums.zg + sums.zzdg;
+
+        return state;
+    }
+
+    // median and quartile range of at most 2^20 strided samples
+    inline std::pair<double, double> initial_estimate(std::span<const double> x) {
+        size_t stride = std::max<size_t>(1, x.size() >> 20);
+
+        std::vector<double> sample;
+        sample.reserve(x.size() / stride + 1);
+        for (size_t i = 0; i < x.size(); i += stride) {
+            sample.push_back(x[i]);
+        }
+
+        auto order = [&](double p) {
+            auto it = sample.begin() + (ptrdiff_t)(p * (double)(sample.size() - 1));
+            std::nth_element(sample.begin(), it, sample.end());
+
+            return *it;
+        };
+
+        double median = order(0.5), q1 = order(0.25), q3 = order(0.75);
+
+        // quantile(3/4) - quantile(1/4) = 2 c saspoint5_quantile(3/4)
+        double c = (q3 - q1) / (2 * saspoint5_quantile(0.75));
+
+        return { median, (c > 0 && std::isfinite(c)) ? c : 1.0 };
+    }
+}
+
+inline saspoint5_fit_result saspoint5_fit(std::span<const double> x, int max_iterations = 64, double tolerance = 1e-12) {
+    using namespace saspoint5_mle;
+
+    assert(x.size() >= 2);
+
+    auto [mu, c] = initial_estimate(x);
+
+    likelihood_state state = likelihood(x, mu, std::log(c));
+
+    int iterations = 0;
+    bool converged = false;
+
+    while (iterations < max_iterations && !converged) {
+        iterations++;
+
+        double a = state.h_mumu, b = state.h_mus, d = state.h_ss;
+        double det = a * d - b * b;
+
+        // newton step where the hessian is negative definite, else diagonally scaled ascent
+        double step_mu, step_s;
+        if (a < 0 && det > 0) {
+            step_mu = (b * state.g_s - d * state.g_mu) / det;
+            step_s = (b * state.g_mu - a * state.g_s) / det;
+        }
+        else {
+            step_mu = state.g_mu / std::max(std::abs(a), std::numeric_limits<double>::min());
+            step_s = state.g_s / std::max(std::abs(d), std::numeric_limits<double>::min());
+        }
+
+        double c_now = std::exp(state.s);
+        double t = std::min({ 1.0, 2 * c_now / std::max(std::abs(step_mu), std::numeric_limits<double>::min()), 1 / std::max(std::abs(step_s), std::numeric_limits<double>::min()) });
+
+        bool accepted = false, stalled = false;
+        for (int k = 0; k < 40 && !accepted; k++, t *= 0.5) {
+            likelihood_state trial = likelihood(x, state.mu + t * step_mu, state.s + t * step_s);
+
+            if (trial.loglikelihood >= state.loglikelihood) {
+                // judged on the full step: a damped one is small whenever t is
+                converged = std::abs(step_mu) <= tolerance * c_now && std::abs(step_s) <= tolerance;
+                // a damped step that only ties the log-likelihood makes no progress
+                stalled = t < 1 && !(trial.loglikelihood > state.loglikelihood);
+                state = trial;
+                accepted = true;
+            }
+        }
+
+        if (!accepted || stalled) {
+            // no ascent within rounding of the log-likelihood: at the maximum only if the full step is small
+            converged = std::abs(step_mu) <= std::sqrt(tolerance) * c_now && std::abs(step_s) <= std::sqrt(tolerance);
+            break;
+        }
+    }
+
+    return { state.mu, std::exp(state.s), state.loglikelihood, iterations, converged };
+}
@@ -0,0 +1,946 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Single precision saspoint5_pdf/cdf/quantile.
+// Same segments and limit transforms as the double functions, with rational approximations of
+// reduced degree (at most 9 + 3 instead of 16 + 16 terms) fitted to a relative error below 1e-8
+// and rounded to float. The polynomials are evaluated by horner, which at these degrees rounds
+// less than estrin; the whole evaluation stays in float, log2 included.
+// The span overloads process 16 (AVX-512F) or 8 (AVX2) lanes per instruction and are
+// bit-identical to the scalar float functions.
+
+#pragma once
+
+#include "saspoint5_distribution_batch.hpp"
+
+namespace saspoint5_detail {
+    inline float fmadd(float a, float b, float c) {
+#if defined(FP_FAST_FMAF)
+        return std::fma(a, b, c);
+#else
+        return a * b + c;
+#endif
+    }
+
+    template <size_t N>
+    inline float poly(float x, const std::array<float, N>& coef) {
+        float y = coef[N - 1];
+
+        for (size_t i = N - 1; i-- > 0;) {
+            y = fmadd(y, x, coef[i]);
+        }
+
+        return y;
+    }
+
+    template <size_t N, size_t M>
+    inline float pade(float x, const std::array<float, N>& numer, const std::array<float, M>& denom) {
+        float sc = poly(x, numer), sd = poly(x, denom);
+
+        assert(sd >= 0.5f);
+
+        return sc / sd;
+    }
+
+    template <const auto& numer, const auto& denom>
+    float pade(float x) {
+        return pade(x, numer, denom);
+    }
+
+    struct pade_segment_float {
+        float offset;
+        std::span<const float> numer, denom;
+        float (*value)(float);
+    };
+
+    inline int pow2_segment(float x, int e0, int count) {
+        int32_t bits = std::bit_cast<int32_t>(std::abs(x)) - 1;
+        int exponent = (int)(bits >> 23) - 127;
+
+        return std::clamp(exponent - e0 + 1, 0, count - 1);
+    }
+}
+
+namespace saspoint5_log2_float {
+    inline constexpr std::array lg = {
+        6.66666627e-1f,
+        4.00009722e-1f,
+        2.84987867e-1f,
+        2.42790788e-1f,
+    };
+
+    inline constexpr float ivln2_hi = 1.44287109e+0f, ivln2_lo = -1.76052854e-4f;
+}
+
+namespace saspoint5_detail {
+    // float log2(x) + shift, fdlibm e_log2f reduction; the integer part is added last as in the double version
+    inline float log2_shift(float x, int shift) {
+        using namespace saspoint5_log2_float;
+
+        uint32_t bits = std::bit_cast<uint32_t>(x);
+        uint32_t carry = ((bits & 0x007FFFFFu) + 0x004AFB0Du) & 0x00800000u;
+
+        float f = std::bit_cast<float>((bits & 0x007FFFFFu) | (carry ^ 0x3F800000u)) - 1;
+        float e = (float)((int)(bits >> 23) - 127 + (int)(carry >> 23) + shift);
+
+        float s = f / (2 + f), z = s * s, hfsq = 0.5f * f * f;
+        float r = s * fmadd(z, poly(z, lg), hfsq);
+
+        float hi = std::bit_cast<float>(std::bit_cast<uint32_t>(f - hfsq) & 0xFFFFF000u);
+        float lo = ((f - hi) - hfsq) + r;
+
+        float val = fmadd(lo + hi, ivln2_lo, lo * ivln2_hi) + hi * ivln2_hi;
+
+        return val + e;
+    }
+}
+
+namespace saspoint5_pdf_pade_float {
+    using namespace saspoint5_detail;
+
+    inline constexpr std::array pade_plus_0_0p125_numer = {
+        6.36619747e-1f,
+        3.17752209e1f,
+        8.14102478e2f,
+        7.70923291e3f,
+    };
+    inline constexpr std::array pade_plus_0_0p125_denom = {
+        1.00000000e0f,
+        4.99123535e1f,
+        1.33882422e3f,
+        1.50939150e4f,
+        6.68108438e4f,
+        8.05265283e3f,
+        4.72847812e4f,
+        -8.29636484e4f,
+    };
+    inline constexpr std::array pade_plus_0p125_0p25_numer = {
+        4.35668409e-1f,
+        2.60862446e0f,
+    };
+    inline constexpr std::array pade_plus_0p125_0p25_denom = {
+        1.00000000e0f,
+        9.49635601e0f,
+        2.41061058e1f,
+        6.75634432e0f,
+        -1.41071618e0f,
+    };
+    inline constexpr std::array pade_plus_0p25_0p5_numer = {
+        2.95645446e-1f,
+        1.16484547e0f,
+        4.75561857e-1f,
+    };
+    inline constexpr std::array pade_plus_0p25_0p5_denom = {
+        1.00000000e0f,
+        6.65878487e0f,
+        1.32979584e1f,
+        7.22577286e0f,
+        5.17978370e-1f,
+    };
+    inline constexpr std::array pade_plus_0p5_1_numer = {
+        1.70762405e-1f,
+        3.24507475e-1f,
+        8.17298666e-2f,
+    };
+    inline constexpr std::array pade_plus_0p5_1_denom = {
+        1.00000000e0f,
+        3.69528341e0f,
+        4.27266884e0f,
+        1.47598875e0f,
+        7.11333603e-2f,
+    };
+    inline constexpr std::array pade_plus_1_2_numer = {
+        8.61071497e-2f,
+        5.99847175e-2f,
+        6.83034305e-3f,
+    };
+    inline constexpr std::array pade_plus_1_2_denom = {
+        1.00000000e0f,
+        1.76677799e0f,
+        9.69872355e-1f,
+        1.65992558e-1f,
+        4.12873877e-3f,
+    };
+    inline constexpr std::array pade_plus_2_4_numer = {
+        3.91428582e-2f,
+        1.26323635e-2f,
+        6.77727920e-4f,
+    };
+    inline constexpr std::array pade_plus_2_4_denom = {
+        1.00000000e0f,
+        9.21572864e-1f,
+        2.59573191e-1f,
+        2.25513652e-2f,
+        2.82754627e-4f,
+    };
+    inline constexpr std::array pade_plus_4_8_numer = {
+        1.65057387e-2f,
+        2.74507049e-3f,
+        7.56123627e-5f,
+    };
+    inline constexpr std::array pade_plus_4_8_denom = {
+        1.00000000e0f,
+        4.88454103e-1f,
+        7.31947348e-2f,
+        3.38822580e-3f,
+        2.25680087e-5f,
+    };
+    inline constexpr std::array pade_plus_8_16_numer = {
+        6.60044793e-3f,
+        5.62638161e-4f,
+        7.92738228e-6f,
+    };
+    inline constexpr std::array pade_plus_8_16_denom = {
+        1.00000000e0f,
+        2.54277050e-1f,
+        1.99279338e-2f,
+        4.83997370e-4f,
+        1.69051418e-6f,
+    };
+    inline constexpr std::array pade_plus_16_32_numer = {
+        2.54339469e-3f,
+        1.09889057e-4f,
+        7.83964651e-7f,
+    };
+    inline constexpr std::array pade_plus_16_32_denom = {
+        1.00000000e0f,
+        1.30497381e-1f,
+        5.26557211e-3f,
+        6.59926591e-5f,
+        1.18898008e-7f,
+    };
+    inline constexpr std::array pade_plus_32_64_numer = {
+        9.55085678e-4f,
+        2.07775065e-5f,
+        7.45979705e-8f,
+    };
+    inline constexpr std::array pade_plus_32_64_denom = {
+        1.00000000e0f,
+        6.63665682e-2f,
+        1.36475463e-3f,
+        8.72950022e-6f,
+        8.02390066e-9f,
+    };
+    inline constexpr std::array pade_plus_limit_numer = {
+        1.99471146e-1f,
+        -8.01042095e-2f,
+        1.15582552e-2f,
+    };
+    inline constexpr std::array pade_plus_limit_denom = {
+        1.00000000e0f,
+        3.96301627e-1f,
+        1.24146581e-1f,
+    };
+
+    inline constexpr std::array<pade_segment_float, 11> pade_segments = {{
+        { 0.0f, pade_plus_0_0p125_numer, pade_plus_0_0p125_denom, pade<pade_plus_0_0p125_numer, pade_plus_0_0p125_denom> },
+        { 0.125f, pade_plus_0p125_0p25_numer, pade_plus_0p125_0p25_denom, pade<pade_plus_0p125_0p25_numer, pade_plus_0p125_0p25_denom> },
+        { 0.25f, pade_plus_0p25_0p5_numer, pade_plus_0p25_0p5_denom, pade<pade_plus_0p25_0p5_numer, pade_plus_0p25_0p5_denom> },
+        { 0.5f, pade_plus_0p5_1_numer, pade_plus_0p5_1_denom, pade<pade_plus_0p5_1_numer, pade_plus_0p5_1_denom> },
+        { 1.0f, pade_plus_1_2_numer, pade_plus_1_2_denom, pade<pade_plus_1_2_numer, pade_plus_1_2_denom> },
+        { 2.0f, pade_plus_2_4_numer, pade_plus_2_4_denom, pade<pade_plus_2_4_numer, pade_plus_2_4_denom> },
+        { 4.0f, pade_plus_4_8_numer, pade_plus_4_8_denom, pade<pade_plus_4_8_numer, pade_plus_4_8_denom> },
+        { 8.0f, pade_plus_8_16_numer, pade_plus_8_16_denom, pade<pade_plus_8_16_numer, pade_plus_8_16_denom> },
+        { 16.0f, pade_plus_16_32_numer, pade_plus_16_32_denom, pade<pade_plus_16_32_numer, pade_plus_16_32_denom> },
+        { 32.0f, pade_plus_32_64_numer, pade_plus_32_64_denom, pade<pade_plus_32_64_numer, pade_plus_32_64_denom> },
+        { 0.0f, pade_plus_limit_numer, pade_plus_limit_denom, pade<pade_plus_limit_numer, pade_plus_limit_denom> },
+    }};
+}
+
+namespace saspoint5_cdf_pade_float {
+    using namespace saspoint5_detail;
+
+    inline constexpr std::array pade_plus_0_0p5_numer = {
+        5.00000000e-1f,
+        1.23964615e1f,
+        1.24148453e2f,
+        1.30941742e2f,
+        -6.80086374e0f,
+        -9.88816147e1f,
+        2.51387924e2f,
+        -3.61020935e2f,
+        2.95658203e2f,
+        -1.06508064e2f,
+    };
+    inline constexpr std::array pade_plus_0_0p5_denom = {
+        1.00000000e0f,
+        2.60661850e1f,
+        2.81477570e2f,
+        5.95913086e2f,
+    };
+    inline constexpr std::array pade_plus_0p5_1_numer = {
+        3.31309557e-1f,
+        4.25907224e-1f,
+        9.34174508e-2f,
+    };
+    inline constexpr std::array pade_plus_0p5_1_denom = {
+        1.00000000e0f,
+        1.80094254e0f,
+        7.47642040e-1f,
+        3.98683660e-2f,
+    };
+    inline constexpr std::array pade_plus_1_2_numer = {
+        2.71280318e-1f,
+        2.06540659e-1f,
+        2.69997939e-2f,
+    };
+    inline constexpr std::array pade_plus_1_2_denom = {
+        1.00000000e0f,
+        1.07876444e0f,
+        2.72115052e-1f,
+        8.88825674e-3f,
+    };
+    inline constexpr std::array pade_plus_2_4_numer = {
+        2.13928163e-1f,
+        1.09954007e-1f,
+        1.27098626e-2f,
+        1.81342373e-4f,
+    };
+    inline constexpr std::array pade_plus_2_4_denom = {
+        1.00000000e0f,
+        6.96948230e-1f,
+        1.32148057e-1f,
+        5.72606968e-3f,
+    };
+    inline constexpr std::array pade_plus_4_8_numer = {
+        1.63772807e-1f,
+        4.35497314e-2f,
+        2.60050222e-3f,
+        1.91106501e-5f,
+    };
+    inline constexpr std::array pade_plus_4_8_denom = {
+        1.00000000e0f,
+        3.66699874e-1f,
+        3.66029441e-2f,
+        8.33688595e-4f,
+    };
+    inline constexpr std::array pade_plus_8_16_numer = {
+        1.22610122e-1f,
+        1.65721513e-2f,
+        5.02561044e-4f,
+        1.87278079e-6f,
+    };
+    inline constexpr std::array pade_plus_8_16_denom = {
+        1.00000000e0f,
+        1.88994169e-1f,
+        9.72318090e-3f,
+        1.13999020e-4f,
+    };
+    inline constexpr std::array pade_plus_16_32_numer = {
+        9.03056115e-2f,
+        6.15300424e-3f,
+        9.40209939e-5f,
+        1.76408648e-7f,
+    };
+    inline constexpr std::array pade_plus_16_32_denom = {
+        1.00000000e0f,
+        9.62996408e-2f,
+        2.52411142e-3f,
+        1.50629239e-5f,
+    };
+    inline constexpr std::array pade_plus_32_64_numer = {
+        6.57333583e-2f,
+        2.24862038e-3f,
+        1.72470536e-5f,
+        1.62370331e-8f,
+    };
+    inline constexpr std::array pade_plus_32_64_denom = {
+        1.00000000e0f,
+        4.87378985e-2f,
+        6.46429951e-4f,
+        1.95068424e-6f,
+    };
+    inline constexpr std::array pade_plus_limit_numer = {
+        3.98942292e-1f,
+    };
+    inline constexpr std::array pade_plus_limit_denom = {
+        1.00000000e0f,
+        3.98941666e-1f,
+        7.58459419e-2f,
+        -3.31022986e-3f,
+    };
+
+    inline constexpr std::array<pade_segment_float, 9> pade_segments = {{
+        { 0.0f, pade_plus_0_0p5_numer, pade_plus_0_0p5_denom, pade<pade_plus_0_0p5_numer, pade_plus_0_0p5_denom> },
+        { 0.5f, pade_plus_0p5_1_numer, pade_plus_0p5_1_denom, pade<pade_plus_0p5_1_numer, pade_plus_0p5_1_denom> },
+        { 1.0f, pade_plus_1_2_numer, pade_plus_1_2_denom, pade<pade_plus_1_2_numer, pade_plus_1_2_denom> },
+        { 2.0f, pade_plus_2_4_numer, pade_plus_2_4_denom, pade<pade_plus_2_4_numer, pade_plus_2_4_denom> },
+        { 4.0f, pade_plus_4_8_numer, pade_plus_4_8_denom, pade<pade_plus_4_8_numer, pade_plus_4_8_denom> },
+        { 8.0f, pade_plus_8_16_numer, pade_plus_8_16_denom, pade<pade_plus_8_16_numer, pade_plus_8_16_denom> },
+        { 16.0f, pade_plus_16_32_numer, pade_plus_16_32_denom, pade<pade_plus_16_32_numer, pade_plus_16_32_denom> },
+        { 32.0f, pade_plus_32_64_numer, pade_plus_32_64_denom, pade<pade_plus_32_64_numer, pade_plus_32_64_denom> },
+        { 0.0f, pade_plus_limit_numer, pade_plus_limit_denom, pade<pade_plus_limit_numer, pade_plus_limit_denom> },
+    }};
+}
+
+namespace saspoint5_quantile_pade_float {
+    using namespace saspoint5_detail;
+
+    inline constexpr std::array pade_plus_expm1_1p125_numer = {
+        0.00000000e0f,
+        1.36099130e-1f,
+        3.55002785e0f,
+        4.20738716e1f,
+        1.45321564e2f,
+    };
+    inline constexpr std::array pade_plus_expm1_1p125_denom = {
+        1.00000000e0f,
+        2.78170128e1f,
+        3.49891663e2f,
+        1.48268286e3f,
+        4.95382477e2f,
+    };
+    inline constexpr std::array pade_plus_expm1p125_1p25_numer = {
+        1.46698654e-2f,
+        1.62593320e-1f,
+        3.57724279e-1f,
+        -3.15334722e-2f,
+    };
+    inline constexpr std::array pade_plus_expm1p125_1p25_denom = {
+        1.00000000e0f,
+        3.91223860e0f,
+        8.86530638e-1f,
+    };
+    inline constexpr std::array pade_plus_expm1p25_1p5_numer = {
+        2.69627869e-2f,
+        1.66477025e-1f,
+        2.34672785e-1f,
+    };
+    inline constexpr std::array pade_plus_expm1p25_1p5_denom = {
+        1.00000000e0f,
+        2.74196935e0f,
+        7.87098408e-1f,
+        9.03063267e-2f,
+    };
+    inline constexpr std::array pade_plus_expm1p5_2_numer = {
+        4.79518659e-2f,
+        1.60639495e-1f,
+        1.28798768e-1f,
+        -1.56068464e-3f,
+    };
+    inline constexpr std::array pade_plus_expm1p5_2_denom = {
+        1.00000000e0f,
+        1.75663483e0f,
+        4.53780681e-1f,
+        4.74323966e-2f,
+        -3.52039421e-3f,
+    };
+    inline constexpr std::array pade_plus_expm2_4_numer = {
+        8.02395493e-2f,
+        1.37739569e-1f,
+        5.98126054e-2f,
+        2.20154063e-3f,
+        1.62063821e-4f,
+    };
+    inline constexpr std::array pade_plus_expm2_4_denom = {
+        1.00000000e0f,
+        1.04157186e0f,
+        2.71898448e-1f,
+        3.07066143e-2f,
+    };
+    inline constexpr std::array pade_plus_expm4_8_numer = {
+        1.39293492e-1f,
+        6.01829104e-2f,
+        6.25716383e-3f,
+        5.31374943e-4f,
+    };
+    inline constexpr std::array pade_plus_expm4_8_denom = {
+        1.00000000e0f,
+        3.33405435e-1f,
+        4.60835323e-2f,
+        2.82302755e-3f,
+        1.67503367e-5f,
+    };
+    inline constexpr std::array pade_plus_expm8_16_numer = {
+        1.57911658e-1f,
+        6.46309331e-2f,
+        1.16914799e-2f,
+        1.21567957e-3f,
+        7.31288164e-5f,
+    };
+    inline constexpr std::array pade_plus_expm8_16_denom = {
+        1.00000000e0f,
+        4.03828561e-1f,
+        7.37251714e-2f,
+        7.62334839e-3f,
+        4.59824252e-4f,
+    };
+    inline constexpr std::array pade_plus_expm16_32_numer = {
+        1.59150079e-1f,
+        7.41133168e-2f,
+        1.47420969e-2f,
+        2.65346887e-3f,
+    };
+    inline constexpr std::array pade_plus_expm16_32_denom = {
+        1.00000000e0f,
+        4.65660691e-1f,
+        9.26278755e-2f,
+        1.66722219e-2f,
+    };
+    inline constexpr std::array pade_plus_expm32_64_numer = {
+        1.59154937e-1f,
+    };
+    inline constexpr std::array pade_plus_expm32_64_denom = {
+        1.00000000e0f,
+    };
+
+    inline constexpr std::array<pade_segment_float, 9> pade_segments = {{
+        { 0.0f, pade_plus_expm1_1p125_numer, pade_plus_expm1_1p125_denom, pade<pade_plus_expm1_1p125_numer, pade_plus_expm1_1p125_denom> },
+        { 0.125f, pade_plus_expm1p125_1p25_numer, pade_plus_expm1p125_1p25_denom, pade<pade_plus_expm1p125_1p25_numer, pade_plus_expm1p125_1p25_denom> },
+        { 0.25f, pade_plus_expm1p25_1p5_numer, pade_plus_expm1p25_1p5_denom, pade<pade_plus_expm1p25_1p5_numer, pade_plus_expm1p25_1p5_denom> },
+        { 0.5f, pade_plus_expm1p5_2_numer, pade_plus_expm1p5_2_denom, pade<pade_plus_expm1p5_2_numer, pade_plus_expm1p5_2_denom> },
+        { 0.0f, pade_plus_expm2_4_numer, pade_plus_expm2_4_denom, pade<pade_plus_expm2_4_numer, pade_plus_expm2_4_denom> },
+        { 0.0f, pade_plus_expm4_8_numer, pade_plus_expm4_8_denom, pade<pade_plus_expm4_8_numer, pade_plus_expm4_8_denom> },
+        { 0.0f, pade_plus_expm8_16_numer, pade_plus_expm8_16_denom, pade<pade_plus_expm8_16_numer, pade_plus_expm8_16_denom> },
+        { 0.0f, pade_plus_expm16_32_numer, pade_plus_expm16_32_denom, pade<pade_plus_expm16_32_numer, pade_plus_expm16_32_denom> },
+        { 0.0f, pade_plus_expm32_64_numer, pade_plus_expm32_64_denom, pade<pade_plus_expm32_64_numer, pade_plus_expm32_64_denom> },
+    }};
+}
+
+inline float saspoint5_pdf(float x) {
+    using namespace saspoint5_pdf_pade_float;
+
+    x = std::abs(x);
+
+    int index = pow2_segment(x, -3, (int)pade_segments.size());
+    const pade_segment_float& segment = pade_segments[index];
+
+    float y;
+    if (index < (int)pade_segments.size() - 1) {
+        y = segment.value(x - segment.offset);
+    }
+    else {
+        float v = std::sqrt(x);
+        float u = 1 / v;
+
+        // u / x rounds twice where u^3 would triple the error of u
+        y = segment.value(u) * (u / x);
+    }
+
+    return y;
+}
+
+inline float saspoint5_cdf(float x, bool complementary = false) {
+    using namespace saspoint5_cdf_pade_float;
+
+    bool inversion = (x <= 0) ^ complementary;
+
+    x = std::abs(x);
+
+    int index = pow2_segment(x, -1, (int)pade_segments.size());
+    const pade_segment_float& segment = pade_segments[index];
+
+    float y;
+    if (index < (int)pade_segments.size() - 1) {
+        y = segment.value(x - segment.offset);
+    }
+    else {
+        float v = std::sqrt(x);
+        float u = 1 / v;
+
+        y = segment.value(u) * u;
+    }
+
+    y = inversion ? y : 1 - y;
+
+    return y;
+}
+
+inline float saspoint5_quantile(float x, bool complementary = false) {
+    using namespace saspoint5_quantile_pade_float;
+
+    bool flip = x > 0.5f;
+    x = flip ? 1 - x : x;
+    complementary ^= flip;
+
+    if (!(x >= 0)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    float v;
+    int exponent = (int)(std::bit_cast<uint32_t>(std::abs(x)) >> 23) - 127;
+
+    if (exponent >= -64) {
+        int m = (exponent >= -2) ? 1 : std::bit_width((unsigned int)(-exponent - 1));
+        float u = -log2_shift(x, 1 << (m - 1));
+
+        int index = (m > 1) ? (m + 2) : pow2_segment(u, -3, 4);
+        const pade_segment_float& segment = pade_segments[index];
+
+        v = segment.value(u - segment.offset);
+    }
+    else {
+        v = (float)std::ldexp(1 / std::numbers::pi, -1);
+    }
+
+    // x^2 is subnormal below 2^-63: square x 2^32 and scale v by 2^64 instead
+    float w = x * 0x1p32f;
+    float y = (v * 0x1p64f) / (w * w);
+
+    y = complementary ? y : -y;
+
+    return y;
+}
+
+namespace saspoint5_simd {
+    namespace pdf {
+        inline constexpr auto table_float = build_pade_table<
+            max_numer_size(saspoint5_pdf_pade_float::pade_segments), max_denom_size(saspoint5_pdf_pade_float::pade_segments)
+        >(saspoint5_pdf_pade_float::pade_segments);
+    }
+
+    namespace cdf {
+        inline constexpr auto table_float = build_pade_table<
+            max_numer_size(saspoint5_cdf_pade_float::pade_segments), max_denom_size(saspoint5_cdf_pade_float::pade_segments)
+        >(saspoint5_cdf_pade_float::pade_segments);
+    }
+
+    namespace quantile {
+        inline constexpr std::array shifts_float = {
+            0.0f, 32.0f, 16.0f, 8.0f, 4.0f, 2.0f, 1.0f
+        };
+
+        inline constexpr auto table_float = build_pade_table<
+            max_numer_size(saspoint5_quantile_pade_float::pade_segments), max_denom_size(saspoint5_quantile_pade_float::pade_segments)
+        >(saspoint5_quantile_pade_float::pade_segments);
+    }
+
+#if defined(__AVX512F__)
+    struct avx512_float {
+        using vfloat = __m512;
+        using vmask = __mmask16;
+        using vindex = __m512i;
+
+        static constexpr size_t lanes = 16;
+
+        static vfloat load(const float* p) { return _mm512_loadu_ps(p); }
+        static void store(float* p, vfloat v) { _mm512_storeu_ps(p, v); }
+        static vfloat set1(float v) { return _mm512_set1_ps(v); }
+
+        static vfloat add(vfloat a, vfloat b) { return _mm512_add_ps(a, b); }
+        static vfloat sub(vfloat a, vfloat b) { return _mm512_sub_ps(a, b); }
+        static vfloat mul(vfloat a, vfloat b) { return _mm512_mul_ps(a, b); }
+        static vfloat div(vfloat a, vfloat b) { return _mm512_div_ps(a, b); }
+        static vfloat sqrt(vfloat v) { return _mm512_maskz_sqrt_ps(0xFFFF, v); }
+        static vfloat abs(vfloat v) { return _mm512_abs_ps(v); }
+        static vfloat neg(vfloat v) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(v), _mm512_set1_epi32(INT32_MIN))); }
+
+        static vfloat bits(uint32_t v) { return _mm512_castsi512_ps(_mm512_set1_epi32((int32_t)v)); }
+        static vfloat band(vfloat a, vfloat b) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+        static vfloat bor(vfloat a, vfloat b) { return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+        static vfloat bxor(vfloat a, vfloat b) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+        static vfloat iadd(vfloat a, vfloat b) { return _mm512_castsi512_ps(_mm512_add_epi32(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+
+        static vfloat muladd(vfloat a, vfloat b, vfloat c) {
+#if defined(__FMA__)
+            return _mm512_fmadd_ps(a, b, c);
+#else
+            return _mm512_add_ps(_mm512_mul_ps(a, b), c);
+#endif
+        }
+
+        static vmask gt(vfloat a, vfloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+        static vmask ge(vfloat a, vfloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+        static vmask le(vfloat a, vfloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+        static vmask eq(vfloat a, vfloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+        static vmask bnot(vmask m) { return (vmask)~m; }
+        static bool any(vmask m) { return m != 0; }
+
+        static vfloat select(vmask m, vfloat a, vfloat b) { return _mm512_mask_blend_ps(m, b, a); }
+        static vfloat count(vfloat c, vmask m) { return _mm512_mask_add_ps(c, m, c, _mm512_set1_ps(1.0f)); }
+
+        static vindex index(vfloat c) { return _mm512_maskz_cvttps_epi32(0xFFFF, c); }
+        static vfloat gather(const float* base, vindex idx) { return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, idx, base, 4); }
+
+        static vfloat exponent(vfloat v) {
+            __m512i e = _mm512_maskz_srli_epi32(0xFFFF, _mm512_castps_si512(_mm512_abs_ps(v)), 23);
+
+            return _mm512_maskz_cvtepi32_ps(0xFFFF, _mm512_sub_epi32(e, _mm512_set1_epi32(127)));
+        }
+    };
+#endif
+
+#if defined(__AVX2__)
+    struct avx2_float {
+        using vfloat = __m256;
+        using vmask = __m256;
+        using vindex = __m256i;
+
+        static constexpr size_t lanes = 8;
+
+        static vfloat load(const float* p) { return _mm256_loadu_ps(p); }
+        static void store(float* p, vfloat v) { _mm256_storeu_ps(p, v); }
+        static vfloat set1(float v) { return _mm256_set1_ps(v); }
+
+        static vfloat add(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+        static vfloat sub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+        static vfloat mul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+        static vfloat div(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+        static vfloat sqrt(vfloat v) { return _mm256_sqrt_ps(v); }
+        static vfloat abs(vfloat v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+        static vfloat neg(vfloat v) { return _mm256_xor_ps(_mm256_set1_ps(-0.0f), v); }
+
+        static vfloat bits(uint32_t v) { return _mm256_castsi256_ps(_mm256_set1_epi32((int32_t)v)); }
+        static vfloat band(vfloat a, vfloat b) { return _mm256_and_ps(a, b); }
+        static vfloat bor(vfloat a, vfloat b) { return _mm256_or_ps(a, b); }
+        static vfloat bxor(vfloat a, vfloat b) { return _mm256_xor_ps(a, b); }
+        static vfloat iadd(vfloat a, vfloat b) { return _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(a), _mm256_castps_si256(b))); }
+
+        static vfloat muladd(vfloat a, vfloat b, vfloat c) {
+#if defined(__FMA__)
+            return _mm256_fmadd_ps(a, b, c);
+#else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+        }
+
+        static vmask gt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static vmask ge(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static vmask le(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static vmask eq(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        static vmask bnot(vmask m) { return _mm256_xor_ps(m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+        static bool any(vmask m) { return _mm256_movemask_ps(m) != 0; }
+
+        static vfloat select(vmask m, vfloat a, vfloat b) { return _mm256_blendv_ps(b, a, m); }
+        static vfloat count(vfloat c, vmask m) { return _mm256_add_ps(c, _mm256_and_ps(m, _mm256_set1_ps(1.0f))); }
+
+        static vindex index(vfloat c) { return _mm256_cvttps_epi32(c); }
+        static vfloat gather(const float* base, vindex idx) { return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, idx, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4); }
+
+        static vfloat exponent(vfloat v) {
+            __m256i e = _mm256_srli_epi32(_mm256_castps_si256(abs(v)), 23);
+
+            return _mm256_cvtepi32_ps(_mm256_sub_epi32(e, _mm256_set1_epi32(127)));
+        }
+    };
+#endif
+
+    // horner over the gathered coefficients; the zero padding at the top leaves the result unchanged
+    template <class simd, size_t S, size_t N>
+    typename simd::vfloat poly(typename simd::vfloat x, typename simd::vindex idx, const std::array<std::array<float, S>, N>& coef, size_t n) {
+        typename simd::vfloat y = simd::gather(coef[n - 1].data(), idx);
+
+        for (size_t i = n - 1; i-- > 0;) {
+            y = simd::muladd(y, x, simd::gather(coef[i].data(), idx));
+        }
+
+        return y;
+    }
+
+    template <class simd, size_t N>
+    typename simd::vfloat poly(typename simd::vfloat x, const std::array<float, N>& coef) {
+        typename simd::vfloat y = simd::set1(coef[N - 1]);
+
+        for (size_t i = N - 1; i-- > 0;) {
+            y = simd::muladd(y, x, simd::set1(coef[i]));
+        }
+
+        return y;
+    }
+
+    // lane-wise scalar float log2_shift
+    template <class simd>
+    typename simd::vfloat log2_shift(typename simd::vfloat x, typename simd::vfloat shift) {
+        using vfloat = typename simd::vfloat;
+        using namespace saspoint5_log2_float;
+
+        const vfloat zero = simd::set1(0.0f), one = simd::set1(1.0f), two = simd::set1(2.0f), half = simd::set1(0.5f);
+
+        vfloat carry = simd::band(simd::iadd(simd::band(x, simd::bits(0x007FFFFFu)), simd::bits(0x004AFB0Du)), simd::bits(0x00800000u));
+
+        vfloat f = simd::sub(simd::bor(simd::band(x, simd::bits(0x007FFFFFu)), simd::bxor(carry, simd::bits(0x3F800000u))), one);
+        vfloat e = simd::add(simd::add(simd::exponent(x), simd::select(simd::gt(carry, zero), one, zero)), shift);
+
+        vfloat s = simd::div(f, simd::add(two, f)), z = simd::mul(s, s), hfsq = simd::mul(simd::mul(half, f), f);
+        vfloat r = simd::mul(s, simd::muladd(z, poly<simd>(z, lg), hfsq));
+
+        vfloat hi = simd::band(simd::sub(f, hfsq), simd::bits(0xFFFFF000u));
+        vfloat lo = simd::add(simd::sub(simd::sub(f, hi), hfsq), r);
+
+        vfloat val = simd::add(simd::muladd(simd::add(lo, hi), simd::set1(ivln2_lo), simd::mul(lo, simd::set1(ivln2_hi))), simd::mul(hi, simd::set1(ivln2_hi)));
+
+        return simd::add(val, e);
+    }
+
+    template <class simd, size_t S, size_t N, size_t M>
+    typename simd::vfloat pade(typename simd::vfloat x, typename simd::vindex idx, typename simd::vmask head, const pade_table<S, N, M, float>& table) {
+        bool full = simd::any(head);
+
+        typename simd::vfloat sc = poly<simd>(x, idx, table.numer, full ? N : table.numer_tail);
+        typename simd::vfloat sd = poly<simd>(x, idx, table.denom, full ? M : table.denom_tail);
+
+        return simd::div(sc, sd);
+    }
+
+    template <class simd>
+    void pdf_kernel(const float* xs, float* ys, size_t n) {
+        using vfloat = typename simd::vfloat;
+
+        const vfloat zero = simd::set1(0.0f), one = simd::set1(1.0f);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vfloat x = simd::abs(simd::load(xs + i));
+
+            vfloat c = zero;
+            for (double bound : pdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1((float)bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1((float)pdf::bounds.back()));
+
+            vfloat v = simd::sqrt(x);
+            vfloat u = simd::div(one, v);
+
+            vfloat t = simd::select(limit, u, simd::sub(x, simd::gather(pdf::table_float.offset.data(), idx)));
+            vfloat y = pade<simd>(t, idx, simd::eq(c, zero), pdf::table_float);
+
+            y = simd::mul(y, simd::select(limit, simd::div(u, x), one));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_pdf(xs[i]);
+        }
+    }
+
+    template <class simd>
+    void cdf_kernel(const float* xs, float* ys, size_t n, bool complementary) {
+        using vfloat = typename simd::vfloat;
+
+        const vfloat zero = simd::set1(0.0f), one = simd::set1(1.0f);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vfloat x = simd::load(xs + i);
+
+            typename simd::vmask inversion = simd::le(x, zero);
+            if (complementary) {
+                inversion = simd::bnot(inversion);
+            }
+
+            x = simd::abs(x);
+
+            vfloat c = zero;
+            for (double bound : cdf::bounds) {
+                c = simd::count(c, simd::gt(x, simd::set1((float)bound)));
+            }
+
+            typename simd::vindex idx = simd::index(c);
+            typename simd::vmask limit = simd::gt(x, simd::set1((float)cdf::bounds.back()));
+
+            vfloat v = simd::sqrt(x);
+            vfloat u = simd::div(one, v);
+
+            vfloat t = simd::select(limit, u, simd::sub(x, simd::gather(cdf::table_float.offset.data(), idx)));
+            vfloat y = pade<simd>(t, idx, simd::eq(c, zero), cdf::table_float);
+
+            y = simd::mul(y, simd::select(limit, u, one));
+            y = simd::select(inversion, y, simd::sub(one, y));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_cdf(xs[i], complementary);
+        }
+    }
+
+    template <class simd>
+    void quantile_kernel(const float* xs, float* ys, size_t n, bool complementary) {
+        using vfloat = typename simd::vfloat;
+
+        const vfloat zero = simd::set1(0.0f), one = simd::set1(1.0f);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vfloat x = simd::load(xs + i);
+
+            typename simd::vmask flip = simd::gt(x, simd::set1(0.5f));
+            x = simd::select(flip, simd::sub(one, x), x);
+
+            vfloat exponent = simd::exponent(x);
+
+            vfloat c = zero;
+            for (double e : quantile::exponents) {
+                c = simd::count(c, simd::ge(exponent, simd::set1((float)e)));
+            }
+
+            vfloat u = simd::neg(log2_shift<simd>(x, simd::gather(quantile::shifts_float.data(), simd::index(c))));
+
+            typename simd::vmask head = simd::eq(c, simd::set1((float)quantile::exponents.size()));
+
+            vfloat s = zero;
+            for (double bound : quantile::bounds) {
+                s = simd::count(s, simd::gt(u, simd::set1((float)bound)));
+            }
+            s = simd::select(head, s, simd::sub(simd::set1((float)(quantile::exponents.size() + quantile::bounds.size())), c));
+
+            typename simd::vindex idx = simd::index(simd::select(simd::eq(c, zero), zero, s));
+
+            vfloat t = simd::sub(u, simd::gather(quantile::table_float.offset.data(), idx));
+            vfloat v = pade<simd>(t, idx, simd::eq(s, zero), quantile::table_float);
+
+            v = simd::select(simd::eq(c, zero), simd::set1((float)std::ldexp(1 / std::numbers::pi, -1)), v);
+
+            vfloat w = simd::mul(x, simd::set1(0x1p32f));
+            vfloat y = simd::div(simd::mul(v, simd::set1(0x1p64f)), simd::mul(w, w));
+
+            y = complementary ? y : simd::neg(y);
+            y = simd::select(flip, simd::neg(y), y);
+            y = simd::select(simd::ge(x, zero), y, simd::set1(std::numeric_limits<float>::quiet_NaN()));
+
+            simd::store(ys + i, y);
+        }
+
+        for (; i < n; i++) {
+            ys[i] = saspoint5_quantile(xs[i], complementary);
+        }
+    }
+}
+
+inline void saspoint5_pdf(std::span<const float> x, std::span<float> y) {
+    assert(x.size() == y.size());
+
+#if defined(__AVX512F__)
+    saspoint5_simd::pdf_kernel<saspoint5_simd::avx512_float>(x.data(), y.data(), x.size());
+#elif defined(__AVX2__)
+    saspoint5_simd::pdf_kernel<saspoint5_simd::avx2_float>(x.data(), y.data(), x.size());
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_pdf(x[i]);
+    }
+#endif
+}
+
+inline void saspoint5_cdf(std::span<const float> x, std::span<float> y, bool complementary = false) {
+    assert(x.size() == y.size());
+
+#if defined(__AVX512F__)
+    saspoint5_simd::cdf_kernel<saspoint5_simd::avx512_float>(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX2__)
+    saspoint5_simd::cdf_kernel<saspoint5_simd::avx2_float>(x.data(), y.data(), x.size(), complementary);
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_cdf(x[i], complementary);
+    }
+#endif
+}
+
+inline void saspoint5_quantile(std::span<const float> x, std::span<float> y, bool complementary = false) {
+    assert(x.size() == y.size());
+
+#if defined(__AVX512F__)
+    saspoint5_simd::quantile_kernel<saspoint5_simd::avx512_float>(x.data(), y.data(), x.size(), complementary);
+#elif defined(__AVX2__)
+    saspoint5_simd::quantile_kernel<saspoint5_simd::avx2_float>(x.data(), y.data(), x.size(), complementary);
+#else
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = saspoint5_quantile(x[i], complementary);
+    }
+#endif
+}
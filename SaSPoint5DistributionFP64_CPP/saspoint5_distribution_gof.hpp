@@ -0,0 +1,347 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Kolmogorov-Smirnov and Anderson-Darling goodness-of-fit tests against SaS(alpha=1/2, mu, c).
+// The sample is sorted in parallel, the cdf and ccdf of the standardized order statistics are
+// evaluated by the sorted-range functions, and D = sup |F_n - F| and
+// A^2 = -n - (1/n) sum (2i - 1) log F(x_i) + (2(n - i) + 1) log(1 - F(x_i))
+// are reduced over threads in the block order of saspoint5_simd::parallel_reduce.
+// log(1 - F) is taken of the ccdf, so the upper tail keeps its accuracy.
+//   saspoint5_gof_test:      mu and c given; asymptotic p-values (Kolmogorov with Stephens'
+//                            correction, Marsaglia's ADinf).
+//   saspoint5_gof_bootstrap: mu and c fitted by saspoint5_fit; parametric bootstrap p-values.
+//                            Both statistics are pivotal under the location-scale equivariant fit,
+//                            so the replicates are drawn from the standard distribution.
+//   saspoint5_gof_sample:    accumulates the sample from streamed chunks as sorted runs, merged on test.
+// A sample containing nan yields nan statistics and p-values.
+// With libstdc++ and oneTBB headers installed, <execution> requires linking -ltbb.
+
+#pragma once
+
+#include <random>
+
+#include "saspoint5_distribution_fit.hpp"
+#include "saspoint5_distribution_parallel.hpp"
+#include "saspoint5_distribution_random.hpp"
+#include "saspoint5_distribution_sorted.hpp"
+
+struct saspoint5_gof_result {
+    size_t n;
+    // location and scale tested against, the maximum likelihood fit for saspoint5_gof_bootstrap
+    double mu, c;
+    // kolmogorov-smirnov D and anderson-darling A^2
+    double ks, ad;
+    double ks_pvalue, ad_pvalue;
+};
+
+namespace saspoint5_gof {
+    // max of i/n - F(x_i) and F(x_i) - (i - 1)/n, and the anderson-darling sum, over a block of order statistics
+    struct edf_sums {
+        double d_plus = 0, d_minus = 0;
+        saspoint5_simd::compensated_sum ad;
+
+        void add(const edf_sums& other) {
+            d_plus = std::max(d_plus, other.d_plus);
+            d_minus = std::max(d_minus, other.d_minus);
+            ad.add(other.ad);
+        }
+    };
+
+    // order statistics [begin, end) of the ascending xs[0, n)
+    inline edf_sums edf_range(const double* xs, size_t begin, size_t end, size_t n, double mu, double c_inv) {
+        constexpr size_t chunk_size = 512;
+
+        std::array<double, chunk_size> z, cdf, ccdf;
+
+        double nn = (double)n;
+
+        edf_sums sums;
+
+        for (size_t i = begin; i < end; i += chunk_size) {
+            size_t m = std::min(chunk_size, end - i);
+
+            for (size_t j = 0; j < m; j++) {
+                z[j] = (xs[i + j] - mu) * c_inv;
+            }
+
+            saspoint5_cdf_sorted(std::span<const double>(z.data(), m), std::span<double>(cdf.data(), m));
+            saspoint5_cdf_sorted(std::span<const double>(z.data(), m), std::span<double>(ccdf.data(), m), true);
+
+            for (size_t j = 0; j < m; j++) {
+                // k = i - 1 of the 1-based order statistic
+                double k = (double)(i + j);
+
+                sums.d_plus = std::max(sums.d_plus, (k + 1) / nn - cdf[j]);
+                sums.d_minus = std::max(sums.d_minus, cdf[j] - k / nn);
+                sums.ad.add((2 * k + 1) * std::log(cdf[j]) + (2 * (nn - k) - 1) * std::log(ccdf[j]));
+            }
+        }
+
+        return sums;
+    }
+
+    inline bool has_nan(std::span<const double> x) {
+        return std::any_of(std::execution::par_unseq, x.begin(), x.end(), [](double v) { return std::isnan(v); });
+    }
+
+    inline void sort(std::span<double> x, bool parallel = true) {
+        if (parallel) {
+            std::sort(std::execution::par_unseq, x.begin(), x.end());
+        }
+        else {
+            std::sort(x.begin(), x.end());
+        }
+    }
+
+    inline saspoint5_gof_result nan_result(size_t n, double mu, double c) {
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+        return { n, mu, c, nan, nan, nan, nan };
+    }
+
+    // Q(lambda) = P(K > lambda) of the kolmogorov distribution; the theta-function form converges fast below 1
+    inline double kolmogorov_q(double lambda) {
+        if (!(lambda > 0)) {
+            return 1;
+        }
+
+        double sum = 0;
+
+        if (lambda < 1) {
+            double a = -std::numbers::pi * std::numbers::pi / (8 * lambda * lambda);
+
+            for (int k = 1; k <= 8; k++) {
+                sum += std::exp(a * (double)((2 * k - 1) * (2 * k - 1)));
+            }
+
+            return std::clamp(1 - std::sqrt(2 * std::numbers::pi) / lambda * sum, 0.0, 1.0);
+        }
+
+        for (int k = 1; k <= 8; k++) {
+            double term = std::exp(-2 * (double)(k * k) * lambda * lambda);
+
+            sum += (k % 2 == 1) ? term : -term;
+        }
+
+        return std::clamp(2 * sum, 0.0, 1.0);
+    }
+
+    inline double ks_pvalue(double d, size_t n) {
+        double sqrt_n = std::sqrt((double)n);
+
+        return kolmogorov_q((sqrt_n + 0.12 + 0.11 / sqrt_n) * d);
+    }
+
+    // 1 - ADinf(z), G. Marsaglia and J. Marsaglia, Evaluating the Anderson-Darling distribution (2004)
+    inline double ad_pvalue(double z) {
+        if (!(z > 0)) {
+            return 1;
+        }
+        if (z < 2) {
+            return 1 - std::exp(-1.2337141 / z) / std::sqrt(z) *
+                (2.00012 + (0.247105 - (0.0649821 - (0.0347962 - (0.011672 - 0.00168691 * z) * z) * z) * z) * z);
+        }
+
+        return 1 - std::exp(-std::exp(1.0776 - (2.30695 - (0.43424 - (0.082433 - (0.008056 - 0.0003146 * z) * z) * z) * z) * z));
+    }
+
+    // statistics of the ascending, nan-free x against SaS(1/2, mu, c), without p-values
+    inline saspoint5_gof_result statistics(std::span<const double> x, double mu, double c) {
+        size_t n = x.size();
+        double c_inv = 1 / c;
+
+        edf_sums sums = saspoint5_simd::parallel_reduce<edf_sums>(n, 1 << 16, [&](size_t begin, size_t end) {
+            return edf_range(x.data(), begin, end, n, mu, c_inv);
+        });
+
+        double ks = std::max(sums.d_plus, sums.d_minus);
+        double ad = -(double)n - sums.ad.value() / (double)n;
+
+        return { n, mu, c, ks, ad, 1, 1 };
+    }
+
+    // ks and ad of a standard sample of size n refitted by saspoint5_fit; replicate b of seed is reproducible
+    inline std::pair<double, double> replicate(size_t n, uint64_t seed, size_t b, bool parallel) {
+        std::seed_seq seq{ (uint32_t)seed, (uint32_t)(seed >> 32), (uint32_t)b, (uint32_t)((uint64_t)b >> 32) };
+
+        saspoint5_sampler<std::mt19937_64> sampler{ std::mt19937_64(seq) };
+
+        std::vector<double> y(n);
+        sampler.fill(y);
+
+        saspoint5_fit_result fit = saspoint5_fit(y);
+
+        sort(y, parallel);
+
+        saspoint5_gof_result result = statistics(y, fit.mu, fit.c);
+
+        return { result.ks, result.ad };
+    }
+
+    // ascending, nan-free x
+    inline saspoint5_gof_result bootstrap(std::span<const double> x, size_t replicates, uint64_t seed) {
+        assert(x.size() >= 2 && replicates >= 1);
+
+        saspoint5_fit_result fit = saspoint5_fit(x);
+
+        saspoint5_gof_result result = statistics(x, fit.mu, fit.c);
+
+        // small samples run one replicate per pool task, whose fits and reductions then stay on that thread;
+        // large ones run the replicates in turn and use the pool within each
+        bool parallel = x.size() >= saspoint5_parallel::min_parallel_size;
+
+        std::vector<std::pair<double, double>> stats(replicates);
+
+        if (parallel) {
+            for (size_t b = 0; b < replicates; b++) {
+                stats[b] = replicate(x.size(), seed, b, true);
+            }
+        }
+        else {
+            saspoint5_parallel::thread_pool::instance().run(replicates, [&](size_t b) {
+                stats[b] = replicate(x.size(), seed, b, false);
+            });
+        }
+
+        size_t ks_count = 0, ad_count = 0;
+        for (const auto& [ks, ad] : stats) {
+            ks_count += (ks >= result.ks) ? 1 : 0;
+            ad_count += (ad >= result.ad) ? 1 : 0;
+        }
+
+        result.ks_pvalue = (double)(ks_count + 1) / (double)(replicates + 1);
+        result.ad_pvalue = (double)(ad_count + 1) / (double)(replicates + 1);
+
+        return result;
+    }
+}
+
+// x ascending
+inline saspoint5_gof_result saspoint5_gof_test_sorted(std::span<const double> x, double mu = 0, double c = 1) {
+    using namespace saspoint5_gof;
+
+    assert(x.size() >= 1 && c > 0);
+    assert(std::is_sorted(x.begin(), x.end()));
+
+    if (has_nan(x)) {
+        return nan_result(x.size(), mu, c);
+    }
+
+    saspoint5_gof_result result = statistics(x, mu, c);
+
+    result.ks_pvalue = ks_pvalue(result.ks, result.n);
+    result.ad_pvalue = ad_pvalue(result.ad);
+
+    return result;
+}
+
+inline saspoint5_gof_result saspoint5_gof_test(std::span<const double> x, double mu = 0, double c = 1) {
+    using namespace saspoint5_gof;
+
+    if (has_nan(x)) {
+        return nan_result(x.size(), mu, c);
+    }
+
+    std::vector<double> sorted(x.begin(), x.end());
+    sort(sorted);
+
+    return saspoint5_gof_test_sorted(sorted, mu, c);
+}
+
+inline saspoint5_gof_result saspoint5_gof_bootstrap(std::span<const double> x, size_t replicates = 1000, uint64_t seed = 0) {
+    using namespace saspoint5_gof;
+
+    if (has_nan(x)) {
+        return nan_result(x.size(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    std::vector<double> sorted(x.begin(), x.end());
+    sort(sorted);
+
+    return bootstrap(sorted, replicates, seed);
+}
+
+// sample accumulated over streamed chunks; each append sorts its chunk as a run, test merges the runs
+class saspoint5_gof_sample {
+public:
+    void append(std::span<const double> chunk) {
+        if (saspoint5_gof::has_nan(chunk)) {
+            nan_ = true;
+            return;
+        }
+
+        size_t begin = values_.size();
+
+        values_.insert(values_.end(), chunk.begin(), chunk.end());
+        saspoint5_gof::sort(std::span<double>(values_).subspan(begin));
+
+        run_ends_.push_back(values_.size());
+    }
+
+    void clear() {
+        values_.clear();
+        run_ends_.clear();
+        nan_ = false;
+    }
+
+    size_t size() const {
+        return values_.size();
+    }
+
+    bool has_nan() const {
+        return nan_;
+    }
+
+    // the values appended so far, ascending
+    std::span<const double> sorted() {
+        merge();
+
+        return values_;
+    }
+
+    saspoint5_gof_result test(double mu = 0, double c = 1) {
+        if (nan_) {
+            return saspoint5_gof::nan_result(size(), mu, c);
+        }
+
+        return saspoint5_gof_test_sorted(sorted(), mu, c);
+    }
+
+    saspoint5_gof_result bootstrap(size_t replicates = 1000, uint64_t seed = 0) {
+        if (nan_) {
+            return saspoint5_gof::nan_result(size(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+        }
+
+        return saspoint5_gof::bootstrap(sorted(), replicates, seed);
+    }
+
+private:
+    std::vector<double> values_;
+    std::vector<size_t> run_ends_;
+    bool nan_ = false;
+
+    // pairwise merges of adjacent runs, log2(runs) passes over the values
+    void merge() {
+        while (run_ends_.size() > 1) {
+            std::vector<size_t> ends;
+
+            for (size_t k = 0; k < run_ends_.size(); k += 2) {
+                if (k + 1 < run_ends_.size()) {
+                    size_t begin = (k > 0) ? run_ends_[k - 1] : 0;
+
+                    std::inplace_merge(std::execution::par_unseq,
+                        values_.begin() + (ptrdiff_t)begin, values_.begin() + (ptrdiff_t)run_ends_[k], values_.begin() + (ptrdiff_t)run_ends_[k + 1]);
+
+                    ends.push_back(run_ends_[k + 1]);
+                }
+                else {
+                    ends.push_back(run_ends_[k]);
+                }
+            }
+
+            run_ends_ = std::move(ends);
+        }
+    }
+};
@@ -0,0 +1,164 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Multithreaded batch evaluation for very large arrays.
+// saspoint5_pdf/cdf/quantile(std::execution::par or par_unseq, x, y) split the arrays over
+// the threads of saspoint5_parallel::thread_pool; seq and unseq stay on the calling thread
+// (the batch kernels are already simd). Each thread owns a contiguous range, evaluated in cache-sized
+// chunks claimed from an atomic cursor; a thread that runs out steals chunks from the other ranges.
+// saspoint5_first_touch zero-fills a fresh output array with the same partition, which the pool runs
+// on the same threads, so that its pages are placed on the numa node of the thread that later writes them.
+// Arrays shorter than min_parallel_size per thread are evaluated single-threaded. An exception from
+// one chunk cancels the chunks not yet claimed and is rethrown to the caller.
+// With libstdc++ and oneTBB headers installed, <execution> requires linking -ltbb.
+
+#pragma once
+
+#include <atomic>
+#include <execution>
+#include <type_traits>
+
+#include "saspoint5_distribution_batch.hpp"
+#include "saspoint5_distribution_pool.hpp"
+
+namespace saspoint5_parallel {
+    // 32 KiB of input and 32 KiB of output per chunk
+    inline constexpr size_t chunk_size = 4096;
+
+    inline constexpr size_t min_parallel_size = 1 << 16;
+
+    template <class ExecutionPolicy>
+    inline constexpr bool is_parallel_policy =
+        std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::parallel_policy> ||
+        std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::parallel_unsequenced_policy>;
+
+    // threads = 0: size of the thread pool
+    inline size_t thread_count(size_t n, size_t threads = 0) {
+        if (n / min_parallel_size <= 1) {
+            return 1;
+        }
+
+        if (threads == 0) {
+            threads = thread_pool::instance().size();
+        }
+
+        return std::clamp<size_t>(n / min_parallel_size, 1, threads);
+    }
+
+    // start of the range owned by thread t, aligned to chunk_size
+    inline size_t range_begin(size_t n, size_t threads, size_t t) {
+        size_t chunks = (n + chunk_size - 1) / chunk_size;
+        size_t block = (chunks + threads - 1) / threads * chunk_size;
+
+        return std::min(n, t * block);
+    }
+
+    // calls func(begin, end) for every chunk of [0, n)
+    template <class F>
+    void for_each_chunk(size_t n, F func, size_t threads = 0) {
+        threads = thread_count(n, threads);
+
+        if (threads <= 1) {
+            for (size_t i = 0; i < n; i += chunk_size) {
+                func(i, std::min(n, i + chunk_size));
+            }
+
+            return;
+        }
+
+        struct alignas(64) range {
+            std::atomic<size_t> next;
+            size_t end;
+        };
+
+        std::vector<range> ranges(threads);
+        for (size_t t = 0; t < threads; t++) {
+            ranges[t].next.store(range_begin(n, threads, t), std::memory_order_relaxed);
+            ranges[t].end = range_begin(n, threads, t + 1);
+        }
+
+        auto worker = [&](size_t t) {
+            for (size_t k = 0; k < threads; k++) {
+                range& r = ranges[(t + k) % threads];
+
+                for (;;) {
+                    size_t begin = r.next.fetch_add(chunk_size, std::memory_order_relaxed);
+                    if (begin >= r.end) {
+                        break;
+                    }
+
+                    try {
+                        func(begin, std::min(r.end, begin + chunk_size));
+                    }
+                    catch (...) {
+                        for (range& q : ranges) {
+                            q.next.store(q.end, std::memory_order_relaxed);
+                        }
+
+                        throw;
+                    }
+                }
+            }
+        };
+
+        thread_pool::instance().run(threads, worker);
+    }
+}
+
+// zero-fills y with the thread partition of for_each_chunk
+inline void saspoint5_first_touch(std::span<double> y, size_t threads = 0) {
+    threads = saspoint5_parallel::thread_count(y.size(), threads);
+
+    auto touch = [&](size_t t) {
+        size_t begin = saspoint5_parallel::range_begin(y.size(), threads, t);
+        size_t end = saspoint5_parallel::range_begin(y.size(), threads, t + 1);
+
+        std::fill(y.begin() + (ptrdiff_t)begin, y.begin() + (ptrdiff_t)end, 0.0);
+    };
+
+    if (threads <= 1) {
+        touch(0);
+
+        return;
+    }
+
+    saspoint5_parallel::thread_pool::instance().run(threads, touch);
+}
+
+template <class ExecutionPolicy>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+void saspoint5_pdf(ExecutionPolicy&&, std::span<const double> x, std::span<double> y) {
+    assert(x.size() == y.size());
+
+    size_t threads = saspoint5_parallel::is_parallel_policy<ExecutionPolicy> ? 0 : 1;
+
+    saspoint5_parallel::for_each_chunk(x.size(), [&](size_t begin, size_t end) {
+        saspoint5_pdf(x.subspan(begin, end - begin), y.subspan(begin, end - begin));
+    }, threads);
+}
+
+template <class ExecutionPolicy>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+void saspoint5_cdf(ExecutionPolicy&&, std::span<const double> x, std::span<double> y, bool complementary = false) {
+    assert(x.size() == y.size());
+
+    size_t threads = saspoint5_parallel::is_parallel_policy<ExecutionPolicy> ? 0 : 1;
+
+    saspoint5_parallel::for_each_chunk(x.size(), [&](size_t begin, size_t end) {
+        saspoint5_cdf(x.subspan(begin, end - begin), y.subspan(begin, end - begin), complementary);
+    }, threads);
+}
+
+template <class ExecutionPolicy>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+void saspoint5_quantile(ExecutionPolicy&&, std::span<const double> x, std::span<double> y, bool complementary = false) {
+    assert(x.size() == y.size());
+
+    size_t threads = saspoint5_parallel::is_parallel_policy<ExecutionPolicy> ? 0 : 1;
+
+    saspoint5_parallel::for_each_chunk(x.size(), [&](size_t begin, size_t end) {
+        saspoint5_quantile(x.subspan(begin, end - begin), y.subspan(begin, end - begin), complementary);
+    }, threads);
+}
@@ -0,0 +1,170 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Persistent worker threads shared by the threaded batch, reduction and bootstrap functions.
+// thread_pool::instance() starts hardware_concurrency - 1 workers on first use; they sleep on a
+// condition variable between jobs and are never joined. run(tasks, func) calls func(t) for every t
+// in [0, tasks): the calling thread runs task 0 and worker w task w + 1, so equal task indices of
+// successive jobs land on the same thread, and tasks beyond the pool size are claimed from an atomic
+// counter. run returns after every task has finished. The first exception thrown by a task is
+// rethrown from run once all workers are idle again; tasks not yet started are then skipped.
+// Jobs from different threads are serialized, and run called from inside a task evaluates its tasks
+// in order on the calling thread. Workers that fail to start are dropped and the pool runs smaller.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace saspoint5_parallel {
+    class thread_pool {
+    public:
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        // leaked, so that exit never destroys state a sleeping worker still waits on
+        static thread_pool& instance() {
+            static thread_pool* pool = new thread_pool();
+
+            return *pool;
+        }
+
+        // number of threads running a job, the caller included
+        size_t size() const {
+            return threads_.size() + 1;
+        }
+
+        template <class F>
+        void run(size_t tasks, F func) {
+            if (tasks <= 1 || threads_.empty() || in_task_) {
+                for (size_t t = 0; t < tasks; t++) {
+                    func(t);
+                }
+
+                return;
+            }
+
+            std::lock_guard<std::mutex> serial(run_mutex_);
+
+            dispatch([](void* context, size_t t) { (*static_cast<F*>(context))(t); }, &func, tasks);
+        }
+
+    private:
+        std::mutex mutex_, run_mutex_;
+        std::condition_variable wake_, done_;
+
+        // current job, written under mutex_ before generation_ is advanced
+        void (*invoke_)(void*, size_t) = nullptr;
+        void* context_ = nullptr;
+        size_t tasks_ = 0, participants_ = 0, pending_ = 0, generation_ = 0;
+        std::atomic<size_t> next_{ 0 };
+        std::atomic<bool> failed_{ false };
+        std::exception_ptr error_;
+
+        std::vector<std::thread> threads_;
+
+        static inline thread_local bool in_task_ = false;
+
+        thread_pool() {
+            size_t count = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+
+            threads_.reserve(count);
+
+            for (size_t w = 0; w < count; w++) {
+                try {
+                    threads_.emplace_back(&thread_pool::work, this, w + 1);
+                }
+                catch (const std::system_error&) {
+                    break;
+                }
+            }
+        }
+
+        void dispatch(void (*invoke)(void*, size_t), void* context, size_t tasks) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                invoke_ = invoke;
+                context_ = context;
+                tasks_ = tasks;
+                participants_ = std::min(tasks, size());
+                pending_ = participants_ - 1;
+                next_.store(size(), std::memory_order_relaxed);
+                failed_.store(false, std::memory_order_relaxed);
+                error_ = nullptr;
+                generation_++;
+            }
+
+            wake_.notify_all();
+
+            participate(0);
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this] { return pending_ == 0; });
+
+            if (error_) {
+                std::exception_ptr error = std::exchange(error_, nullptr);
+
+                lock.unlock();
+
+                std::rethrow_exception(error);
+            }
+        }
+
+        // task p, then tasks claimed from next_
+        void participate(size_t p) {
+            bool nested = std::exchange(in_task_, true);
+
+            for (size_t t = p; t < tasks_ && !failed_.load(std::memory_order_relaxed); t = next_.fetch_add(1, std::memory_order_relaxed)) {
+                try {
+                    invoke_(context_, t);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    if (!error_) {
+                        error_ = std::current_exception();
+                    }
+
+                    failed_.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            in_task_ = nested;
+        }
+
+        void work(size_t p) {
+            in_task_ = true;
+
+            size_t seen = 0;
+
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            for (;;) {
+                wake_.wait(lock, [&] { return generation_ != seen; });
+                seen = generation_;
+
+                if (p >= participants_) {
+                    continue;
+                }
+
+                lock.unlock();
+                participate(p);
+                lock.lock();
+
+                if (--pending_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    };
+}
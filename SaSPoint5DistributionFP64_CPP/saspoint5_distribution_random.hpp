@@ -0,0 +1,249 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Random variate generation of the standard SaS(alpha=1/2) distribution (mu = 0, c = 1)
+// from any uniform random bit generator.
+//   inverse: saspoint5_quantile of a uniform in (0, 1); fill() runs the batch quantile kernels.
+//   levy:    (1/Z1^2 - 1/Z2^2) / 4, the difference of two Levy variates, with Z1, Z2 drawn
+//            by the marsaglia polar method: one log per sample and no trigonometric functions.
+//   guide:   the inverse method through saspoint5_guide_table, a cubic lookup in place of the pade
+//            and the log2 of saspoint5_quantile; same uniforms, variates within the table tolerance.
+
+#pragma once
+
+#include <random>
+#include <utility>
+
+#include "saspoint5_distribution_fast.hpp"
+
+enum class saspoint5_sampling {
+    inverse, levy, guide
+};
+
+template <class URBG>
+uint64_t saspoint5_random_bits53(URBG& engine) {
+    if constexpr (URBG::min() == 0 && URBG::max() == std::numeric_limits<uint64_t>::max()) {
+        return (uint64_t)engine() >> 11;
+    }
+    else if constexpr (URBG::min() == 0 && URBG::max() == std::numeric_limits<uint32_t>::max()) {
+        uint64_t hi = (uint64_t)engine(), lo = (uint64_t)engine();
+
+        return ((hi << 32) | lo) >> 11;
+    }
+    else {
+        return std::uniform_int_distribution<uint64_t>(0, (1ull << 53) - 1)(engine);
+    }
+}
+
+// uniform in the open interval (0, 1), same as RandomExtension.NextUniformOpenInterval01
+template <class URBG>
+double saspoint5_uniform_open01(URBG& engine) {
+    return (double)(saspoint5_random_bits53(engine) | 1ull) * 0x1p-53;
+}
+
+// saspoint5_quantile(u) by a guide table over the octave of p = min(u, 1 - u) in [2^-53, 1/2), read from
+// the exponent bits. Each octave tabulates g(p) = quantile(p) p^2 / (p - 1/2), which tends to 1 / (2 pi)
+// in the tail and to 1 / (4 pdf(0)) at the median, as piecewise cubics (saspoint5_interp::cubic_table),
+// and quantile(u) = -+g(p) (p - 1/2) / p^2. Octaves that miss the tolerance with max_count cubics,
+// and u outside the table, are evaluated by saspoint5_quantile.
+// The span overload gathers the cubics in the avx2/avx512 kernels and matches the scalar results bit for bit.
+class saspoint5_guide_table {
+public:
+    static constexpr int octaves = 52;
+
+    explicit saspoint5_guide_table(double tolerance = 1e-12, size_t max_count = 1 << 12) : tolerance_(tolerance) {
+        assert(tolerance > 0);
+
+        const double median = 0.25 / saspoint5_pdf(0.0);
+
+        auto g = [median](double p) {
+            return (p < 0.5) ? saspoint5_quantile(p) * p * p / (p - 0.5) : median;
+        };
+
+        for (int s = 0; s < octaves; s++) {
+            bool accurate = table_.append(g, std::ldexp(1, s - 53), std::ldexp(1, s - 52), tolerance, max_count);
+
+            exact_[s] = accurate ? 0.0 : 1.0;
+        }
+    }
+
+    // shared table of the default tolerance, built on first use
+    static const saspoint5_guide_table& standard() {
+        static const saspoint5_guide_table table;
+
+        return table;
+    }
+
+    double tolerance() const {
+        return tolerance_;
+    }
+
+    // number of tabulated cubics
+    size_t table_size() const {
+        return table_.size();
+    }
+
+    // number of octaves evaluated by saspoint5_quantile
+    size_t exact_octaves() const {
+        return (size_t)std::count(exact_.begin(), exact_.end(), 1.0);
+    }
+
+    double quantile(double u) const {
+        bool flip = u > 0.5;
+        double p = flip ? 1 - u : u;
+
+        int s = (int)(std::bit_cast<uint64_t>(p) >> 52) - 1023 + 53;
+
+        if (s < 0 || s >= octaves || exact_[s] != 0) {
+            return saspoint5_quantile(u);
+        }
+
+        double y = table_.value((size_t)s, p) * (p - 0.5) / (p * p);
+
+        return flip ? -y : y;
+    }
+
+    void quantile(std::span<const double> u, std::span<double> y) const {
+        assert(u.size() == y.size());
+
+#if defined(__AVX512F__)
+        quantile_kernel<saspoint5_simd::avx512>(u.data(), y.data(), u.size());
+#elif defined(__AVX2__)
+        quantile_kernel<saspoint5_simd::avx2>(u.data(), y.data(), u.size());
+#else
+        for (size_t i = 0; i < u.size(); i++) {
+            y[i] = quantile(u[i]);
+        }
+#endif
+    }
+
+private:
+    double tolerance_;
+    saspoint5_interp::cubic_table table_;
+
+    // 1 where the octave is evaluated by saspoint5_quantile, gathered by the kernels
+    std::array<double, octaves> exact_{};
+
+#if defined(__AVX2__)
+    template <class simd>
+    void quantile_kernel(const double* us, double* ys, size_t n) const {
+        using vdouble = typename simd::vdouble;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0), half = simd::set1(0.5);
+
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            vdouble u = simd::load(us + i);
+
+            typename simd::vmask flip = simd::gt(u, half);
+            vdouble p = simd::select(flip, simd::sub(one, u), u);
+
+            typename simd::vmask lower = simd::ge(p, simd::set1(0x1p-53)), upper = simd::gt(half, p);
+
+            vdouble s = simd::add(simd::exponent(p), simd::set1(53.0));
+            s = simd::select(lower, simd::select(upper, s, zero), zero);
+
+            typename simd::vindex idx = simd::index(s);
+
+            vdouble exact = simd::gather(exact_.data(), idx);
+            exact = simd::count(simd::count(exact, simd::bnot(lower)), simd::bnot(upper));
+
+            vdouble y = simd::div(simd::mul(table_.value<simd>(idx, p), simd::sub(p, half)), simd::mul(p, p));
+            y = simd::select(flip, simd::neg(y), y);
+
+            simd::store(ys + i, y);
+
+            if (simd::any(simd::gt(exact, zero))) {
+                for (size_t j = i; j < i + simd::lanes; j++) {
+                    ys[j] = quantile(us[j]);
+                }
+            }
+        }
+
+        for (; i < n; i++) {
+            ys[i] = quantile(us[i]);
+        }
+    }
+#endif
+};
+
+template <class URBG>
+class saspoint5_sampler {
+public:
+    explicit saspoint5_sampler(URBG engine, saspoint5_sampling method = saspoint5_sampling::inverse)
+        : engine_(std::move(engine)), method_(method),
+          guide_((method == saspoint5_sampling::guide) ? &saspoint5_guide_table::standard() : nullptr) {}
+
+    // guide method with a table of another tolerance, which must outlive the sampler
+    saspoint5_sampler(URBG engine, const saspoint5_guide_table& guide)
+        : engine_(std::move(engine)), method_(saspoint5_sampling::guide), guide_(&guide) {}
+
+    URBG& engine() {
+        return engine_;
+    }
+
+    saspoint5_sampling method() const {
+        return method_;
+    }
+
+    double operator()() {
+        switch (method_) {
+        case saspoint5_sampling::inverse:
+            return sample_inverse();
+        case saspoint5_sampling::guide:
+            return guide_->quantile(saspoint5_uniform_open01(engine_));
+        default:
+            return sample_levy();
+        }
+    }
+
+    void fill(std::span<double> y) {
+        if (method_ != saspoint5_sampling::levy) {
+            for (double& v : y) {
+                v = saspoint5_uniform_open01(engine_);
+            }
+
+            if (method_ == saspoint5_sampling::inverse) {
+                saspoint5_quantile(std::span<const double>(y), y);
+            }
+            else {
+                guide_->quantile(std::span<const double>(y), y);
+            }
+        }
+        else {
+            for (double& v : y) {
+                v = sample_levy();
+            }
+        }
+    }
+
+private:
+    URBG engine_;
+    saspoint5_sampling method_;
+    const saspoint5_guide_table* guide_;
+
+    double sample_inverse() {
+        return saspoint5_quantile(saspoint5_uniform_open01(engine_));
+    }
+
+    // Z_i = x_i sqrt(-2 log(s) / s), s = x1^2 + x2^2 < 1
+    // (1/Z1^2 - 1/Z2^2) / 4 = s (x2^2 - x1^2) / (-8 log(s) x1^2 x2^2)
+    // x_i = 2u - 1 with u = (2k + 1) / 2^53 never vanishes
+    double sample_levy() {
+        double x1, x2, s;
+
+        do {
+            x1 = 2 * saspoint5_uniform_open01(engine_) - 1;
+            x2 = 2 * saspoint5_uniform_open01(engine_) - 1;
+            s = x1 * x1 + x2 * x2;
+        } while (s >= 1);
+
+        double x1_sq = x1 * x1, x2_sq = x2 * x2;
+
+        double y = s * (x2_sq - x1_sq) / (-8 * std::log(s) * x1_sq * x2_sq);
+
+        return y;
+    }
+};
@@ -0,0 +1,401 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Evaluation of saspoint5_pdf/cdf/quantile over monotone arrays (sweeps, plot grids).
+// On a monotone x the pade segment is constant over contiguous runs; each run is located by
+// binary search and evaluated with its own coefficients as compile-time broadcast constants,
+// in place of the per-lane segment counting and coefficient gathers of the batch kernels.
+// The estrin pairing and fma use are those of the batch kernels, so the output is bit-identical
+// to the batch functions (and, without SASPOINT5_DISPATCH, to the scalar functions).
+// x must be non-decreasing or non-increasing and free of nan; other input yields unspecified values.
+// With SASPOINT5_DISPATCH the avx2/avx512 paths are chosen at run time together with the batch kernels;
+// otherwise, without AVX-512F or AVX2 at compile time, these forward to the batch functions.
+// saspoint5_interval_probability turns ascending bin edges into bin masses with one evaluation per edge:
+// the cdf at or below the median, the ccdf above it, and each bin differences the tail it lies in.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "saspoint5_distribution_batch.hpp"
+
+namespace saspoint5_sorted {
+    using namespace saspoint5_detail;
+
+    // a run: one segment on one side of the median; the central segment 0 spans both sides
+    struct run_key {
+        int segment;
+        bool side;
+
+        friend bool operator==(run_key, run_key) = default;
+    };
+
+    inline run_key pdf_key(double x) {
+        int segment = pow2_segment(x, -3, (int)saspoint5_pdf_pade::pade_segments.size());
+
+        return { segment, segment > 0 && std::signbit(x) };
+    }
+
+    inline run_key cdf_key(double x) {
+        int segment = pow2_segment(x, -1, (int)saspoint5_cdf_pade::pade_segments.size());
+
+        return { segment, segment > 0 && std::signbit(x) };
+    }
+
+    // segment of saspoint5_quantile, pade_segments.size() for the constant below 2^-64, -1 outside [0, 1]
+    inline run_key quantile_key(double x) {
+        bool flip = x > 0.5;
+        x = flip ? 1 - x : x;
+
+        if (!(x >= 0)) {
+            return { -1, flip };
+        }
+
+        int exponent = (int)(std::bit_cast<uint64_t>(x) >> 52) - 1023;
+        if (exponent < -64) {
+            return { (int)saspoint5_quantile_pade::pade_segments.size(), flip };
+        }
+
+        int m = (exponent >= -2) ? 1 : std::bit_width((unsigned int)(-exponent - 1));
+        int segment = (m > 1) ? (m + 2) : pow2_segment(-log2_shift(x, 1), -3, 4);
+
+        return { segment, segment > 0 && flip };
+    }
+
+    // end of the run starting at x[begin]; the keys of a monotone x form contiguous runs
+    template <class Key>
+    size_t run_end(std::span<const double> x, size_t begin, Key key) {
+        run_key k = key(x[begin]);
+
+        auto it = std::partition_point(x.begin() + begin + 1, x.end(), [&](double v) { return key(v) == k; });
+
+        return (size_t)(it - x.begin());
+    }
+
+    // coefficients of segments[S] as fixed-size arrays for the broadcast poly
+    template <const auto& segments, size_t S>
+    struct segment_coef {
+        static constexpr size_t N = segments[S].numer.size(), M = segments[S].denom.size();
+
+        static constexpr std::array<double, N> numer = [] {
+            std::array<double, N> c{};
+            std::copy(segments[S].numer.begin(), segments[S].numer.end(), c.begin());
+            return c;
+        }();
+
+        static constexpr std::array<double, M> denom = [] {
+            std::array<double, M> c{};
+            std::copy(segments[S].denom.begin(), segments[S].denom.end(), c.begin());
+            return c;
+        }();
+
+        template <class simd>
+        static typename simd::vdouble value(typename simd::vdouble x) {
+            return simd::div(saspoint5_simd::poly<simd>(x, numer), saspoint5_simd::poly<simd>(x, denom));
+        }
+    };
+
+    // f(std::integral_constant<size_t, segment>) for segment in [0, Count), nothing otherwise
+    template <size_t Count, class F>
+    void visit_segment(int segment, F f) {
+        [&]<size_t... S>(std::index_sequence<S...>) {
+            (void)((segment == (int)S ? (f(std::integral_constant<size_t, S>{}), true) : false) || ...);
+        }(std::make_index_sequence<Count>{});
+    }
+
+    // eval over whole vectors, the last n % lanes elements through one vector padded with the last element,
+    // so that every element rounds as in the vector kernels
+    template <class simd, class F>
+    void for_each_vector(const double* xs, double* ys, size_t n, F eval) {
+        size_t i = 0;
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            simd::store(ys + i, eval(simd::load(xs + i)));
+        }
+
+        if (i < n) {
+            double x[simd::lanes], y[simd::lanes];
+
+            for (size_t k = 0; k < simd::lanes; k++) {
+                x[k] = xs[std::min(i + k, n - 1)];
+            }
+
+            simd::store(y, eval(simd::load(x)));
+
+            std::copy(y, y + (n - i), ys + i);
+        }
+    }
+
+    template <class simd, size_t S>
+    void pdf_run(const double* xs, double* ys, size_t n) {
+        using namespace saspoint5_pdf_pade;
+        using vdouble = typename simd::vdouble;
+        using coef = segment_coef<pade_segments, S>;
+
+        const vdouble one = simd::set1(1.0), offset = simd::set1(pade_segments[S].offset);
+
+        for_each_vector<simd>(xs, ys, n, [&](vdouble x) {
+            x = simd::abs(x);
+
+            if constexpr (S < pade_segments.size() - 1) {
+                return coef::template value<simd>(simd::sub(x, offset));
+            }
+            else {
+                vdouble u = simd::div(one, simd::sqrt(x));
+
+                return simd::mul(coef::template value<simd>(u), simd::mul(simd::mul(u, u), u));
+            }
+        });
+    }
+
+    template <class simd, size_t S>
+    void cdf_run(const double* xs, double* ys, size_t n, bool complementary) {
+        using namespace saspoint5_cdf_pade;
+        using vdouble = typename simd::vdouble;
+        using coef = segment_coef<pade_segments, S>;
+
+        const vdouble zero = simd::set1(0.0), one = simd::set1(1.0), offset = simd::set1(pade_segments[S].offset);
+
+        for_each_vector<simd>(xs, ys, n, [&](vdouble x) {
+            vdouble y;
+
+            typename simd::vmask inversion = simd::le(x, zero);
+            if (complementary) {
+                inversion = simd::bnot(inversion);
+            }
+
+            x = simd::abs(x);
+
+            if constexpr (S < pade_segments.size() - 1) {
+                y = coef::template value<simd>(simd::sub(x, offset));
+            }
+            else {
+                vdouble u = simd::div(one, simd::sqrt(x));
+
+                y = simd::mul(coef::template value<simd>(u), u);
+            }
+
+            return simd::select(inversion, y, simd::sub(one, y));
+        });
+    }
+
+    template <class simd, size_t S>
+    void quantile_run(const double* xs, double* ys, size_t n, bool complementary) {
+        using namespace saspoint5_quantile_pade;
+        using vdouble = typename simd::vdouble;
+        using coef = segment_coef<pade_segments, S>;
+
+        // segments 0-3 lie in ilogb(x) >= -2 (shift 1), segment m + 2 in the octave group of shift 2^(m - 1)
+        constexpr double shift = (S >= 4) ? (double)(1 << (S - 3)) : 1.0;
+
+        const vdouble one = simd::set1(1.0), offset = simd::set1(pade_segments[S].offset);
+
+        for_each_vector<simd>(xs, ys, n, [&](vdouble x) {
+            typename simd::vmask flip = simd::gt(x, simd::set1(0.5));
+            x = simd::select(flip, simd::sub(one, x), x);
+
+            vdouble u = simd::neg(saspoint5_simd::log2_shift<simd>(x, simd::set1(shift)));
+            vdouble v = coef::template value<simd>(simd::sub(u, offset));
+
+            vdouble y = simd::div(v, simd::mul(x, x));
+
+            y = complementary ? y : simd::neg(y);
+
+            return simd::select(flip, simd::neg(y), y);
+        });
+    }
+
+    template <class simd>
+    void pdf(std::span<const double> x, std::span<double> y) {
+        for (size_t begin = 0, end; begin < x.size(); begin = end) {
+            end = run_end(x, begin, pdf_key);
+
+            visit_segment<saspoint5_pdf_pade::pade_segments.size()>(pdf_key(x[begin]).segment, [&](auto s) {
+                pdf_run<simd, decltype(s)::value>(x.data() + begin, y.data() + begin, end - begin);
+            });
+        }
+    }
+
+    template <class simd>
+    void cdf(std::span<const double> x, std::span<double> y, bool complementary) {
+        for (size_t begin = 0, end; begin < x.size(); begin = end) {
+            end = run_end(x, begin, cdf_key);
+
+            visit_segment<saspoint5_cdf_pade::pade_segments.size()>(cdf_key(x[begin]).segment, [&](auto s) {
+                cdf_run<simd, decltype(s)::value>(x.data() + begin, y.data() + begin, end - begin, complementary);
+            });
+        }
+    }
+
+    template <class simd>
+    void quantile(std::span<const double> x, std::span<double> y, bool complementary) {
+        for (size_t begin = 0, end; begin < x.size(); begin = end) {
+            end = run_end(x, begin, quantile_key);
+
+            int segment = quantile_key(x[begin]).segment;
+
+            // the constant tail and invalid probabilities have no pade to hoist
+            if (segment < 0 || segment >= (int)saspoint5_quantile_pade::pade_segments.size()) {
+                saspoint5_quantile(x.subspan(begin, end - begin), y.subspan(begin, end - begin), complementary);
+                continue;
+            }
+
+            visit_segment<saspoint5_quantile_pade::pade_segments.size()>(segment, [&](auto s) {
+                quantile_run<simd, decltype(s)::value>(x.data() + begin, y.data() + begin, end - begin, complementary);
+            });
+        }
+    }
+
+    inline bool monotone(std::span<const double> x) {
+        return std::is_sorted(x.begin(), x.end()) || std::is_sorted(x.begin(), x.end(), std::greater<>());
+    }
+}
+
+#if defined(SASPOINT5_DISPATCH)
+namespace saspoint5_dispatch {
+    // the sorted kernels per saspoint5_isa, selected with the batch kernel table
+    struct sorted_kernel_table {
+        void (*pdf)(std::span<const double> x, std::span<double> y);
+        void (*cdf)(std::span<const double> x, std::span<double> y, bool complementary);
+        void (*quantile)(std::span<const double> x, std::span<double> y, bool complementary);
+    };
+
+    inline void pdf_sorted_scalar(std::span<const double> x, std::span<double> y) {
+        pdf_scalar(x.data(), y.data(), x.size());
+    }
+
+    inline void cdf_sorted_scalar(std::span<const double> x, std::span<double> y, bool complementary) {
+        cdf_scalar(x.data(), y.data(), x.size(), complementary);
+    }
+
+    inline void quantile_sorted_scalar(std::span<const double> x, std::span<double> y, bool complementary) {
+        quantile_scalar(x.data(), y.data(), x.size(), complementary);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void pdf_sorted_avx2(std::span<const double> x, std::span<double> y) {
+        saspoint5_sorted::pdf<saspoint5_simd::avx2>(x, y);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void cdf_sorted_avx2(std::span<const double> x, std::span<double> y, bool complementary) {
+        saspoint5_sorted::cdf<saspoint5_simd::avx2>(x, y, complementary);
+    }
+
+    __attribute__((target("avx2,fma"), flatten)) inline void quantile_sorted_avx2(std::span<const double> x, std::span<double> y, bool complementary) {
+        saspoint5_sorted::quantile<saspoint5_simd::avx2>(x, y, complementary);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void pdf_sorted_avx512(std::span<const double> x, std::span<double> y) {
+        saspoint5_sorted::pdf<saspoint5_simd::avx512>(x, y);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void cdf_sorted_avx512(std::span<const double> x, std::span<double> y, bool complementary) {
+        saspoint5_sorted::cdf<saspoint5_simd::avx512>(x, y, complementary);
+    }
+
+    __attribute__((target("avx512f"), flatten)) inline void quantile_sorted_avx512(std::span<const double> x, std::span<double> y, bool complementary) {
+        saspoint5_sorted::quantile<saspoint5_simd::avx512>(x, y, complementary);
+    }
+
+    // indexed by saspoint5_isa
+    inline constexpr std::array<sorted_kernel_table, 3> sorted_tables = {{
+        { pdf_sorted_scalar, cdf_sorted_scalar, quantile_sorted_scalar },
+        { pdf_sorted_avx2, cdf_sorted_avx2, quantile_sorted_avx2 },
+        { pdf_sorted_avx512, cdf_sorted_avx512, quantile_sorted_avx512 },
+    }};
+
+    inline const sorted_kernel_table& sorted_table() {
+        return sorted_tables[(size_t)current().load(std::memory_order_relaxed)];
+    }
+}
+#endif
+
+inline void saspoint5_pdf_sorted(std::span<const double> x, std::span<double> y) {
+    assert(x.size() == y.size());
+    assert(saspoint5_sorted::monotone(x));
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::sorted_table().pdf(x, y);
+#elif defined(__AVX512F__)
+    saspoint5_sorted::pdf<saspoint5_simd::avx512>(x, y);
+#elif defined(__AVX2__)
+    saspoint5_sorted::pdf<saspoint5_simd::avx2>(x, y);
+#else
+    saspoint5_pdf(x, y);
+#endif
+}
+
+inline void saspoint5_cdf_sorted(std::span<const double> x, std::span<double> y, bool complementary = false) {
+    assert(x.size() == y.size());
+    assert(saspoint5_sorted::monotone(x));
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::sorted_table().cdf(x, y, complementary);
+#elif defined(__AVX512F__)
+    saspoint5_sorted::cdf<saspoint5_simd::avx512>(x, y, complementary);
+#elif defined(__AVX2__)
+    saspoint5_sorted::cdf<saspoint5_simd::avx2>(x, y, complementary);
+#else
+    saspoint5_cdf(x, y, complementary);
+#endif
+}
+
+inline void saspoint5_quantile_sorted(std::span<const double> x, std::span<double> y, bool complementary = false) {
+    assert(x.size() == y.size());
+    assert(saspoint5_sorted::monotone(x));
+
+#if defined(SASPOINT5_DISPATCH)
+    saspoint5_dispatch::sorted_table().quantile(x, y, complementary);
+#elif defined(__AVX512F__)
+    saspoint5_sorted::quantile<saspoint5_simd::avx512>(x, y, complementary);
+#elif defined(__AVX2__)
+    saspoint5_sorted::quantile<saspoint5_simd::avx2>(x, y, complementary);
+#else
+    saspoint5_quantile(x, y, complementary);
+#endif
+}
+
+namespace saspoint5_sorted {
+    // probability[i] = P(edges[i] < X <= edges[i + 1]) of SaS(1/2, mu, 1 / c_inv) for ascending edges.
+    // The tail of each standardized edge is computed into probability in place (the last one aside),
+    // then overwritten front to back by the bin masses: tail differences below and above the median,
+    // and 1/2 - tail of each edge for the bin that holds it, so no bin cancels against 1.
+    // The approximations are monotone only to within rounding, so a narrow bin can difference to a
+    // few ulps below zero; masses are clamped at 0.
+    inline void interval_probability(std::span<const double> edges, std::span<double> probability, double mu, double c_inv) {
+        size_t bins = probability.size();
+
+        if (bins == 0) {
+            return;
+        }
+
+        for (size_t i = 0; i < bins; i++) {
+            probability[i] = (edges[i] - mu) * c_inv;
+        }
+
+        size_t lower = (size_t)(std::partition_point(edges.begin(), edges.begin() + (ptrdiff_t)bins, [&](double e) { return e <= mu; }) - edges.begin());
+
+        saspoint5_cdf_sorted(probability.first(lower), probability.first(lower));
+        saspoint5_cdf_sorted(probability.subspan(lower), probability.subspan(lower), true);
+
+        double u = (edges[bins] - mu) * c_inv;
+        double last = saspoint5_cdf(u, u > 0);
+
+        for (size_t i = 0; i < bins; i++) {
+            double a = edges[i], b = edges[i + 1];
+            double ta = probability[i], tb = (i + 1 < bins) ? probability[i + 1] : last;
+
+            probability[i] = std::max(0.0, (b <= mu) ? (tb - ta) : ((a > mu) ? (ta - tb) : ((0.5 - ta) + (0.5 - tb))));
+        }
+    }
+}
+
+// probability[i] = P(edges[i] < X <= edges[i + 1]); edges ascending, may include -inf and inf
+inline void saspoint5_interval_probability(std::span<const double> edges, std::span<double> probability) {
+    assert(edges.size() == probability.size() + 1 || (edges.empty() && probability.empty()));
+    assert(std::is_sorted(edges.begin(), edges.end()));
+
+    saspoint5_sorted::interval_probability(edges, probability, 0, 1);
+}
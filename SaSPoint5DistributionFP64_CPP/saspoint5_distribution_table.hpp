@@ -0,0 +1,187 @@
+// Author and Approximation Formula Coefficient Generator: T.Yoshimura
+// Github: https://github.com/tk-yoshimura
+// Original Code: https://github.com/tk-yoshimura/SaSPoint5DistributionFP64
+// C++20 implement
+//
+// Reference table writer: a column of x and one column per batch function evaluated on it.
+// Rows are evaluated and formatted by std::to_chars in the chunks of saspoint5_parallel::for_each_chunk,
+// each chunk into its own buffer, and the buffers are written in order with one fwrite each.
+// csv:    header line, then "%.16e" values (the text of iostream scientific with precision 16)
+// binary: saspoint5_table_header, the column names each padded with zeros to a multiple of 8 bytes,
+//         then rows x columns little-endian doubles, row-major
+// Write errors throw runtime_error.
+
+#pragma once
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "saspoint5_distribution_parallel.hpp"
+
+enum class saspoint5_table_format {
+    csv, binary
+};
+
+struct saspoint5_table_header {
+    static constexpr std::array<char, 8> magic_value = { 'S', 'A', 'S', 'P', 'T', '5', 'T', 'B' };
+    static constexpr uint32_t version_value = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t columns;
+    uint64_t rows;
+    // bytes of the padded column names following the header
+    uint64_t names_size;
+};
+
+static_assert(sizeof(saspoint5_table_header) == 32);
+
+struct saspoint5_table_column {
+    std::string name;
+    std::function<void(std::span<const double>, std::span<double>)> func;
+};
+
+namespace saspoint5_table {
+    // "-1.2345678901234567e-308" is 24 characters
+    inline constexpr size_t max_value_size = 24;
+
+    inline char* format_value(char* first, double v) {
+        std::to_chars_result result = std::to_chars(first, first + max_value_size, v, std::chars_format::scientific, 16);
+
+        return result.ptr;
+    }
+
+    // zero-terminated and zero-padded to a multiple of 8 bytes, so the values stay aligned
+    inline void append_name(std::string& names, const std::string& name) {
+        names.append(name);
+        names.resize((names.size() + 1 + 7) / 8 * 8, '\0');
+    }
+
+    class file {
+    public:
+        explicit file(const std::string& filepath) : fp_(fopen(filepath.c_str(), "wb")) {
+            if (fp_ == nullptr) {
+                throw std::runtime_error("Failed to open " + filepath + ".");
+            }
+        }
+
+        file(const file&) = delete;
+        file& operator=(const file&) = delete;
+
+        ~file() {
+            if (fp_ != nullptr) {
+                fclose(fp_);
+            }
+        }
+
+        void write(const void* data, size_t size) {
+            if (size > 0 && fwrite(data, 1, size, fp_) != size) {
+                throw std::runtime_error("Failed to write table.");
+            }
+        }
+
+        void close() {
+            int status = fclose(fp_);
+            fp_ = nullptr;
+
+            if (status != 0) {
+                throw std::runtime_error("Failed to close table.");
+            }
+        }
+
+    private:
+        FILE* fp_;
+    };
+}
+
+// x is the first column, named x_name
+inline void saspoint5_write_table(
+    const std::string& filepath, const std::string& x_name, std::span<const double> x,
+    std::span<const saspoint5_table_column> columns, saspoint5_table_format format = saspoint5_table_format::csv) {
+
+    using namespace saspoint5_table;
+    using saspoint5_parallel::chunk_size;
+
+    size_t n = x.size(), width = columns.size() + 1;
+    size_t chunks = (n + chunk_size - 1) / chunk_size;
+
+    std::vector<std::string> buffers(chunks);
+
+    saspoint5_parallel::for_each_chunk(n, [&](size_t begin, size_t end) {
+        size_t rows = end - begin;
+        std::span<const double> xs = x.subspan(begin, rows);
+
+        std::vector<double> values(rows * width);
+        for (size_t i = 0; i < rows; i++) {
+            values[i * width] = xs[i];
+        }
+
+        std::vector<double> y(rows);
+        for (size_t j = 0; j < columns.size(); j++) {
+            columns[j].func(xs, y);
+
+            for (size_t i = 0; i < rows; i++) {
+                values[i * width + j + 1] = y[i];
+            }
+        }
+
+        std::string& buffer = buffers[begin / chunk_size];
+
+        if (format == saspoint5_table_format::binary) {
+            buffer.resize(values.size() * sizeof(double));
+            memcpy(buffer.data(), values.data(), buffer.size());
+            return;
+        }
+
+        buffer.resize(values.size() * (max_value_size + 1));
+
+        char* p = buffer.data();
+        for (size_t i = 0; i < values.size(); i++) {
+            p = format_value(p, values[i]);
+            *p++ = ((i + 1) % width == 0) ? '\n' : ',';
+        }
+
+        buffer.resize((size_t)(p - buffer.data()));
+    });
+
+    file fp(filepath);
+
+    if (format == saspoint5_table_format::binary) {
+        static_assert(std::endian::native == std::endian::little);
+
+        saspoint5_table_header header = {
+            saspoint5_table_header::magic_value, saspoint5_table_header::version_value,
+            (uint32_t)width, n, 0
+        };
+
+        std::string names;
+        append_name(names, x_name);
+        for (const saspoint5_table_column& column : columns) {
+            append_name(names, column.name);
+        }
+
+        header.names_size = names.size();
+
+        fp.write(&header, sizeof(header));
+        fp.write(names.data(), names.size());
+    }
+    else {
+        std::string line = x_name;
+        for (const saspoint5_table_column& column : columns) {
+            line += ',' + column.name;
+        }
+        line += '\n';
+
+        fp.write(line.data(), line.size());
+    }
+
+    for (const std::string& buffer : buffers) {
+        fp.write(buffer.data(), buffer.size());
+    }
+
+    fp.close();
+}